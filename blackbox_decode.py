@@ -0,0 +1,146 @@
+"""Decode a black box image into CSV files or an MCAP file.
+
+The image is a raw copy of the log region, e.g. from an SD card:
+
+    dd if=/dev/sdX of=blackbox.bin bs=4096 count=<blocks>
+    python3 blackbox_decode.py blackbox.bin --csv out/
+    python3 blackbox_decode.py blackbox.bin --mcap run.mcap   # pip install mcap
+
+Record layouts mirror src/Tools/blackbox.hpp.
+"""
+import argparse
+import csv
+import json
+import os
+import struct
+
+BLOCK_MAGIC = 0x42424B47
+BLOCK_HEADER = struct.Struct("<IIHH")
+RECORD_HEADER = struct.Struct("<BBQ")
+
+LIFECYCLE = ["Uninitialized", "Initializing", "Inactive", "Active", "Emergency"]
+
+# type: (name, payload layout, field names)
+RECORDS = {
+    1: ("setpoint", struct.Struct("<fff"), ["throttle", "steering", "brake"]),
+    2: ("sensor", struct.Struct("<fffffffffiffffff"),
+        ["wheel_speed_rl", "wheel_speed_rr", "wheel_distance",
+         "steering_angle_rad", "brake_pressure", "motor_erpm",
+         "motor_current", "motor_duty_cycle", "supply_voltage",
+         "motor_tachometer", "imu_yaw_rate", "imu_accel_x", "imu_accel_y",
+         "est_speed", "est_yaw_rate", "est_slip"]),
+    3: ("state", struct.Struct("<BB"), ["from", "to"]),
+    4: ("link", struct.Struct("<IIII"),
+        ["packets_sent", "packets_dropped", "bytes_received",
+         "records_dropped"]),
+    5: ("can", struct.Struct("<BfffBBIIIIII"),
+        ["port", "tx_fps", "rx_fps", "load_pct", "tx_errors", "rx_errors",
+         "error_passive", "bus_off", "last_recovery_us", "tx_dropped",
+         "tx_retries", "tx_suppressed"]),
+}
+
+
+def read_blocks(path, block_size):
+    """Yields (sequence, records bytes) of every valid block, oldest first."""
+    blocks = []
+    with open(path, "rb") as f:
+        while True:
+            block = f.read(block_size)
+            if len(block) < block_size:
+                break
+            magic, sequence, used, version = BLOCK_HEADER.unpack_from(block)
+            if magic != BLOCK_MAGIC or used > block_size - BLOCK_HEADER.size:
+                continue
+            start = BLOCK_HEADER.size
+            blocks.append((sequence, block[start:start + used]))
+    blocks.sort(key=lambda b: b[0])
+    return blocks
+
+
+def read_records(blocks):
+    """Yields (record name, timestamp_us, dict of fields)."""
+    for _, data in blocks:
+        offset = 0
+        while offset + RECORD_HEADER.size <= len(data):
+            rtype, length, stamp = RECORD_HEADER.unpack_from(data, offset)
+            offset += RECORD_HEADER.size
+            payload = data[offset:offset + length]
+            offset += length
+            if rtype not in RECORDS:
+                continue
+            name, layout, fields = RECORDS[rtype]
+            if len(payload) != layout.size:
+                continue
+            values = dict(zip(fields, layout.unpack(payload)))
+            if name == "state":
+                values = {k: LIFECYCLE[v] if v < len(LIFECYCLE) else v
+                          for k, v in values.items()}
+            yield name, stamp, values
+
+
+def write_csv(records, out_dir):
+    os.makedirs(out_dir, exist_ok=True)
+    files = {}
+    writers = {}
+    try:
+        for name, stamp, values in records:
+            if name not in writers:
+                files[name] = open(os.path.join(out_dir, name + ".csv"), "w",
+                                   newline="")
+                writers[name] = csv.writer(files[name])
+                writers[name].writerow(["timestamp_us"] + list(values))
+            writers[name].writerow([stamp] + list(values.values()))
+    finally:
+        for f in files.values():
+            f.close()
+
+
+def write_mcap(records, path):
+    from mcap.writer import Writer
+
+    with open(path, "wb") as f:
+        writer = Writer(f)
+        writer.start()
+        channels = {}
+        for name, stamp, values in records:
+            if name not in channels:
+                schema = {
+                    "type": "object",
+                    "properties": {k: {"type": "string" if name == "state"
+                                       else "number"} for k in values},
+                }
+                schema_id = writer.register_schema(
+                    name="gkc." + name, encoding="jsonschema",
+                    data=json.dumps(schema).encode())
+                channels[name] = writer.register_channel(
+                    topic="/blackbox/" + name, message_encoding="json",
+                    schema_id=schema_id)
+            stamp_ns = stamp * 1000
+            writer.add_message(channel_id=channels[name], log_time=stamp_ns,
+                               publish_time=stamp_ns,
+                               data=json.dumps(values).encode())
+        writer.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="raw copy of the black box region")
+    parser.add_argument("--block-size", type=int, default=4096,
+                        help="BLACKBOX_BLOCK_SIZE the firmware was built with")
+    parser.add_argument("--csv", metavar="DIR",
+                        help="write one CSV per record type into DIR")
+    parser.add_argument("--mcap", metavar="FILE", help="write an MCAP file")
+    args = parser.parse_args()
+    if not args.csv and not args.mcap:
+        parser.error("choose --csv and/or --mcap")
+
+    blocks = read_blocks(args.image, args.block_size)
+    print("%d blocks" % len(blocks))
+    if args.csv:
+        write_csv(read_records(blocks), args.csv)
+    if args.mcap:
+        write_mcap(read_records(blocks), args.mcap)
+
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,7 @@
 // *************
 // Build Options
 // *************
+#include "vehicle_profiles.hpp" // per-vehicle values, picked by the build environment
 
 // *************
 // Communication
@@ -42,6 +43,8 @@
 #define SEND_QUEUE_SIZE 10
 // interval of sending sensor packets
 #define SEND_SENSOR_INTERVAL_MS 50
+// longest the sensor publisher may stall before the watchdog trips
+#define SEND_SENSOR_LOST_TOLERANCE_MS 1000
 
 // *********
 // Watchdogs
@@ -83,37 +86,47 @@
 // *********
 // Actuation
 // *********
+// Actuator backend: the VESCs and brake on CAN, or the PWM servo and ESC
+// that the RC car profile sets ACTUATOR_PWM for. Any profile can be built
+// with -DACTUATOR_SIM instead, so that the commands drive a first-order model.
 #define CAN1_RX PD_0
 #define CAN1_TX PD_1
 #define CAN1_BAUDRATE 500000
 #define CAN2_RX PB_5
 #define CAN2_TX PB_6
 #define CAN2_BAUDRATE 500000
+#define CAN_MAX_FILTERS 8 // hardware acceptance filters per CAN port
+#define CAN_TX_SLOTS 16 // outgoing frames per bus, one per CAN ID waiting to go out. Must cover every actuator command ID of a bus.
+#define CAN_TX_RETRY_MS 1 // retry interval while all TX mailboxes are busy
+#define CAN_TX_KEEPALIVE_MS 100 // unchanged commands are repeated this often, keep below the actuator timeouts
+#define CAN_TX_DEDUP_SLOTS 8 // actuators whose last command is remembered
+#define ENABLE_CAN_HEALTH //comment to stop monitoring the CAN buses
+#define CAN_HEALTH_INTERVAL_MS 1000
+#define CAN_HEALTH_LOAD_WARN_PCT 60.0 // report a bus above this load as a warning
+#define CAN_HEALTH_RECOVERY_TIMEOUT_MS 100 // after a bus-off restart, wait this long for a frame to go out
 // Throttle
 // #define THROTTLE_PWM_PIN PA_6
-#define CAN_THROTTLE CAN_2
 #define MAX_THROTTLE_SPEED_ERPM 2000
 #define MAX_THROTTLE_CURRENT_MA 5000
 #define MAX_THROTTLE_MS 10
 #define CONST_ERPM2MS 0.0000961111108
 //#define THROTTLE_ERPM_TO_RPS_RATIO 0.1
-#define THROTTLE_VESC_ID 1
 // Braking
-#define CAN_BRAKE CAN_1 // Which CAN bus to use for brake [CAN_1 | CAN_2]
 #define MAX_BRAKE_VAL 3000
 #define MIN_BRAKE_VAL 600
 // Steering
-#define CAN_STEER CAN_2 // Which CAN bus to use for steer [CAN_1 | CAN_2]
 #define MAX_STEER_DEG 100.0
 #define MIN_STEER_DEG -100.0
-#define VIRTUAL_LIMIT_OFF 5
+#define VIRTUAL_LIMIT_OFF 5 // degrees of column travel kept clear of each calibrated stop
 #define NEUTRAL_STEER_DEG 0.0
-#define STEERING_CAL_OFF 0 //this changes the calibration angle
+#define STEERING_CAL_OFF 0 //this changes the calibration angle, degrees added to the calibrated center
 #define MAX_STEER_SPEED_ERPM 50000
 #define MAX_STEER_SPEED_MA 1 //this controls the max steering current i.e strength 
 #define MIN_STEER_SPEED_MA -1 //this controls the max steering current i.e strength 
 
 #define STEERING_CALIB_CURRENT 2700 // mA
+#define STEERING_CALIB_TIMEOUT_MS 3000 // a stop not reached within this fails the calibration
+#define STEERING_CALIB_ENCODER_WAIT_MS 1000 // time the steering encoder gets to become ready before the calibration is skipped
 
 #define MAX_STEER_CURRENT_MA 24000 //this controls the max steering current i.e strength 
 #define MIN_STEER_CURRENT_MA -32000 //this controls the max steering current i.e strength 
@@ -135,18 +148,45 @@
 // #define STEADY_STATE_CURRENT_MULT 0
 #define STEER_DEADBAND_DEG 0.5 //VESC already has a limit of min ERPM := 600. Enything bellow this is already used as 0.
 #define PID_INTERVAL_MS 10
-#define STEER_VESC_ID 2
+#define ENABLE_STEER_PID //comment to leave steering to the VESC position loop
+#define STEER_D_LOWPASS_HZ 20.0 // cutoff of the measured column rate used by the D term
 #define RIGHT_LSWITCH PF_0
 #define LEFT_LSWITCH PF_1
+#if defined(VEHICLE_HAS_RACK_SWITCHES) && !defined(ACTUATOR_SIM)
 #define ENABLE_LSWITCH      //comment to remove limit switches behaviour
+#define ENABLE_STEERING_CALIB //comment to keep STEERING_CAL_OFF and MOTOR_OFFSET instead of finding the center on initialization
+#endif
+#define LSWITCH_PRESSED 0 // pin level with a switch pressed, the pins are pulled up
 
 // Throttle
 #define THROTTLE_CAN_PORT  2 // To which can port should the throttle be sent
 #define THROTTLE_CAN_ID 1    // To which can port should the throttle be sent
-#define THROTTLE_MAX_REVERSE_SPEED 20.0 // m/s
-#define THROTTLE_MAX_FORWARD_SPEED 20.0 // m/s
-#define RC_MAX_SPEED_FORWARD 20.0 // m/s
-#define RC_MAX_SPEED_REVERSE 5.0 // m/s
+// #define ENABLE_DUAL_DRIVE //uncomment for a second rear drive motor, commanded like the first
+#define DRIVE2_CAN_PORT 2
+#define DRIVE2_CAN_ID 3 // VESC IDs are unique across both buses
+#define THROTTLE_MAX_REVERSE_SPEED (::tritonai::gkc::VEHICLE.max_reverse_speed_ms)
+#define THROTTLE_MAX_FORWARD_SPEED (::tritonai::gkc::VEHICLE.max_forward_speed_ms)
+#define RC_MAX_SPEED_FORWARD (::tritonai::gkc::VEHICLE.rc_max_forward_speed_ms)
+#define RC_MAX_SPEED_REVERSE (::tritonai::gkc::VEHICLE.rc_max_reverse_speed_ms)
+#define ENABLE_SPEED_LOOP //comment to pass the speed command straight to the VESC
+#define SPEED_MAX_ACCEL_MS2 4.0 // ramp limit away from standstill
+#define SPEED_MAX_DECEL_MS2 8.0 // ramp limit towards standstill
+#define SPEED_P 0.5 // m/s of command per m/s of ground speed error
+#define SPEED_I 1.0 // m/s of command per m of accumulated error
+#define SPEED_TRIM_MAX_MS 2.0 // integrator limit
+// The slip band needs the state estimator with the IMU for its ground speed
+#define TRACTION_MAX_SLIP 0.15 // allowed motor vs ground speed difference, fraction of ground speed
+#define TRACTION_SLIP_MARGIN_MS 0.5 // plus this, so the kart can launch from standstill
+
+// Setpoint shaping, applied to the commands of the local loops above.
+// Zero disables a limit.
+#define ENABLE_SETPOINT_SHAPING //comment to hand setpoints to the loops unshaped
+#define SHAPE_THROTTLE_JERK_MS3 12.0 // added to the speed loop ramp, whose SPEED_MAX_ACCEL/DECEL_MS2 are the acceleration limits
+#define SHAPE_STEER_RATE_RADS 1.5 // road wheel angle
+#define SHAPE_STEER_ACCEL_RADS2 20.0
+#define SHAPE_STEER_MAX_LAT_ACCEL_MS2 9.0 // above SHAPE_STEER_LIMIT_SPEED_MS, steering is capped to stay below this
+#define SHAPE_STEER_LIMIT_SPEED_MS 4.0
+#define SHAPE_BRAKE_RELEASE_RATE 2.0 // per second, applying the brake is never delayed
 
 // Steering
 #define STEER_CAN_PORT  2 // To which can port should the throttle be sent
@@ -156,36 +196,136 @@
 #define BRAKE_CAN_PORT  1 // To which can port should the throttle be sent
 #define BRAKE_CAN_ID 0x00FF0000    // To which can port should the throttle be sent
 
-#define EMERGENCY_BRAKE_PRESSURE 1.0 // 0.5 bar
+#define EMERGENCY_BRAKE_PRESSURE 1.0 // fraction of the highest pressure in BRAKE_PRESSURE_MAPPING
+#define VESC_ESTOP_BRAKE_REL 1.0 // brake current of every VESC on an emergency stop, fraction of its limit
+// Line pressure reached at each actuator position {position, bar}. Brake
+// commands are a fraction of the last row's pressure.
+// UNCALIBRATED: a linear placeholder with the full travel at 1.0, so the
+// pressure reads as the fraction of travel. Replace it with rows measured
+// with a gauge on the brake line.
+#define BRAKE_PRESSURE_MAPPING {{MIN_BRAKE_VAL, 0.0},\
+                                {MAX_BRAKE_VAL, 1.0}}
+// The position report decoder is not checked against the actuator's
+// documentation or a capture yet, leave the loop open until it is.
+#ifdef VEHICLE_HAS_BRAKE_ACTUATOR
+//#define ENABLE_BRAKE_FEEDBACK //uncomment to close the brake loop on the position reports
+#endif
+#define BRAKE_REPORT_CAN_ID 0x00FF0001 // actuator report frames
+#define BRAKE_STATUS_POLL_INTERVAL_MS 10
+#define BRAKE_STATUS_TIMEOUT_MS 200 // reports older than this are reported as not ready
+#define BRAKE_I 4.0 // position units of trim per position unit of error and second
+#define BRAKE_TRIM_MAX 300 // position units
+#define BRAKE_TOLERANCE 10 // position units, errors below are left alone
+#ifdef VEHICLE_HAS_BRAKE_ACTUATOR
+#define ENABLE_BRAKE_BLENDING //comment to brake with the actuator only (needs ENABLE_SPEED_LOOP)
+#endif
+#define REGEN_BRAKE_EQUIVALENT 0.3 // brake command that full regen current is worth
+#define REGEN_MIN_SPEED_MS 1.0 // regen fades out below REGEN_FULL_SPEED_MS and is off below this
+#define REGEN_FULL_SPEED_MS 3.0
+#define BATTERY_REGEN_TAPER_V 52.0 // regen fades out from this pack voltage
+#define BATTERY_REGEN_CUTOFF_V 54.6 // and is off from this one (full charge)
 
 // *******
 // Sensors
 // *******
+// VESC status feedback (CAN_PACKET_STATUS 1-5)
+#define VESC_STATUS_CAN_PORT 2 // Which CAN port the VESCs report on
+#define VESC_STATUS_POLL_INTERVAL_MS 10
+#define VESC_STATUS_TIMEOUT_MS 200 // status older than this is reported as not ready
+
 // PWM steering encoder
 #define STEER_ENCODER_PIN PC_7
+#define STEER_ENCODER_USE_CAPTURE // measure with TIM3 input capture instead of InterruptIn edges
+#define STEER_ENCODER_POLL_INTERVAL_MS 5
+#define STEER_ENCODER_CENTER_DUTY 0.5 // duty cycle with the steering centered
+#define STEER_ENCODER_RAD_PER_DUTY 6.28318531 // steering column radians per unit duty cycle
+
+// Wheel encoder (quadrature, on the rear axle)
+#define ENABLE_WHEEL_ENCODER //comment to remove the wheel odometry provider
+#define WHEEL_ENCODER_A_PIN PE_9
+#define WHEEL_ENCODER_B_PIN PE_11
+#define WHEEL_ENCODER_USE_TIMER // decode in TIM1 encoder mode instead of per-edge interrupts, A/B must be TIMx CH1/CH2
+#define WHEEL_ENCODER_PPR 100 // pulses per wheel revolution (X4 counts 4x this)
+#define WHEEL_CIRCUMFERENCE_M (::tritonai::gkc::VEHICLE.wheel_circumference_m)
+#define WHEEL_ODOMETRY_POLL_INTERVAL_MS 5
+// Below this many pulses since the last estimate, use the pulse period
+#define WHEEL_ODOMETRY_MIN_COUNT_PULSES 8
+// No pulse for this long means the wheel stopped
+#define WHEEL_ODOMETRY_STOP_TIMEOUT_MS 250
+
+// Steering, the map itself is in the vehicle profile
+#define MIN__WHEEL_STEER_DEG (-::tritonai::gkc::VEHICLE.max_wheel_steer_deg)
+#define MAX__WHEEL_STEER_DEG (::tritonai::gkc::VEHICLE.max_wheel_steer_deg)
+#define MOTOR_OFFSET (::tritonai::gkc::VEHICLE.steer_motor_offset) // actuator position of the center in rad, until the steering is calibrated
+
+// Vehicle geometry, from the vehicle profile
+#define WHEELBASE_M (::tritonai::gkc::VEHICLE.wheelbase_m)
+#define MOTOR_POLE_PAIRS (::tritonai::gkc::VEHICLE.motor_pole_pairs)
+#define DRIVE_GEAR_RATIO (::tritonai::gkc::VEHICLE.drive_gear_ratio) // motor turns per wheel turn
+
+// Filter bank, applied in the sensor reader right after each reading.
+// Zero disables a stage; the median window is in samples and at most 9.
+#define ENABLE_SENSOR_FILTERS //comment to publish raw readings
+#define FILTER_STEERING_MEDIAN 5
+#define FILTER_STEERING_LOWPASS_HZ 20.0
+#define FILTER_MOTOR_CURRENT_LOWPASS_HZ 15.0
+#define FILTER_MOTOR_CURRENT_NOTCH_HZ 0.0
+#define FILTER_BRAKE_LOWPASS_HZ 10.0
+
+// IMU (ICM-42688-P on SPI4)
+#define ENABLE_IMU //comment to remove the IMU provider
+//#define IMU_REPLAY // replay a table of samples instead of reading the IMU (no SPI needed)
+#define IMU_SPI_MOSI PE_6
+#define IMU_SPI_MISO PE_5
+#define IMU_SPI_SCLK PE_2
+#define IMU_SPI_CS PE_4
+#define IMU_SPI_FREQUENCY 10000000
+#define IMU_POLL_INTERVAL_MS 10 // FIFO is drained in one burst per poll
+#define IMU_MAX_BATCH 32 // samples per burst, must cover IMU_POLL_INTERVAL_MS at 1 kHz
+#define IMU_INIT_RETRY_MS 100 // first retry after the IMU did not answer, doubling from there
+#define IMU_INIT_RETRY_MAX_MS 5000
+
+// Vehicle state estimator (EKF over speed, yaw rate and drive wheel slip)
+#define ENABLE_STATE_ESTIMATOR //comment to stop publishing estimates
+#define EST_POLL_INTERVAL_MS 10
+#define EST_Q_SPEED 1.0 // (m/s)^2 per second, acceleration the IMU does not explain
+#define EST_Q_YAW_RATE 4.0 // (rad/s)^2 per second
+#define EST_Q_SLIP 0.05 // per second
+#define EST_R_WHEEL 0.01 // (m/s)^2, wheel encoder speed
+#define EST_R_MOTOR 0.04 // (m/s)^2, speed from the motor ERPM
+#define EST_R_GYRO 0.0004 // (rad/s)^2
+#define EST_R_KINEMATIC 0.04 // (rad/s)^2, bicycle model yaw rate, covers understeer
+#define EST_R_SLIP_PRIOR 0.25 // pulls slip back to zero when nothing else observes it
+
+// *********
+// Black box
+// *********
+// The log is written raw to the start of an SD card on SPI2, no file system.
+// The card needs the SD component, enabled in mbed_app.json.
+#define ENABLE_BLACKBOX //comment to stop logging to the SD card
+#define BLACKBOX_SD_MOSI PB_15
+#define BLACKBOX_SD_MISO PB_14
+#define BLACKBOX_SD_SCLK PB_13
+#define BLACKBOX_SD_CS PB_12
+#define BLACKBOX_SD_FREQUENCY 25000000
+#define BLACKBOX_BLOCK_SIZE 4096 // bytes per buffer, a multiple of the device program size
+#define BLACKBOX_REGION_SIZE (64ull * 1024 * 1024) // bytes at the start of the card used as the log ring, 0 for all of it
+#define BLACKBOX_SENSOR_INTERVAL_MS 5 // sensor snapshot rate, no faster than the fastest sensor
+#define BLACKBOX_FLUSH_MS 500 // longest a record waits in RAM before it is written
+#define BLACKBOX_WRITE_RETRIES 2 // further attempts at a block whose erase or program failed, then it is dropped
+#define BLACKBOX_RETRY_MS 10
 
-// motor angle - left wheel - right wheel - average (in degrees)
-// 0	0	0	0
-// 30	8	10	9
-// 50	9	15	12
-// 70	12	22	17
-// 80	10	30	20
-// 90           23
-// 100          26
-// 110          29
-
-//(in radians)
-#define STERING_MAPPING    {{0, 0,},\
-                            {0.523599, 0.15708,},\
-                            {0.872665, 0.20944,},\
-                            {1.22173, 0.296706,},\
-                            {1.39626, 0.349066,},\
-                            {1.57079, 0.401425},\
-                            {1.74532, 0.453785},\
-                            {1.91986, 0.506145}}; // takes first and last column
-#define MIN__WHEEL_STEER_DEG -20
-#define MAX__WHEEL_STEER_DEG 20
-#define MOTOR_OFFSET 0.3
+// **************
+// Crash recorder
+// **************
+#define ENABLE_CRASH_RECORDER //comment to stop keeping a crash ring in RAM
+// Two ring slots of CRASH_RECORDER_SLOT_SIZE bytes at this address, in RAM
+// the startup code and linker leave alone (D3 SRAM4 on the H743)
+#define CRASH_RECORDER_ADDRESS 0x38000000
+#define CRASH_RECORDER_SLOT_SIZE 32768
+#define CRASH_RECORDER_SENSOR_INTERVAL_MS 20
+#define CRASH_RECORDER_THREAD_STATS_INTERVAL_MS 1000
+#define CRASH_RECORDER_DUMP_INTERVAL_MS 10 // pacing of the dump log packets
 
 // *****
 // ESTOP
@@ -193,9 +333,21 @@
 #define ESTOP_PIN PB_10
 
 //PWM pins for RC car
+// Each output needs a timer of its own from the encoders: TIM3 captures the
+// steering encoder (STEER_ENCODER_USE_CAPTURE) and TIM1 decodes the wheel
+// encoder. PA_6 is TIM3_CH1 by default, so the throttle uses its TIM13_CH1
+// alternate. PwmActuator checks this before it sets up the outputs.
+#define Steer_Pin PA_5 // TIM2_CH1
+#define Throttle_Pin PA_6_ALT0 // TIM13_CH1
+#define PWM_PERIOD_US 20000
+#define PWM_CENTER_US 1500 // neutral pulse
+#define PWM_RANGE_US 500 // pulse change at full scale
+#define PWM_STEER_MAX_RAD 0.5 // steering angle at full scale
+#define PWM_THROTTLE_MAX_MS 5.0 // open-loop speed at full scale
 
-#define Steer_Pin PA_5
-#define Throttle_Pin PA_6
+// Simulated actuators
+#define SIM_SPEED_TAU_S 0.5
+#define SIM_STEER_TAU_S 0.1
 #define Red_Pin PD_12
 
 
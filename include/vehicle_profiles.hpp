@@ -0,0 +1,126 @@
+/**
+ * @file vehicle_profiles.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The values that differ between the vehicles we build, one constexpr
+ * bundle per vehicle, checked at compile time. A build environment picks
+ * one with -DVEHICLE_PROFILE_<NAME>; without one it is the kart. The
+ * profile also sets the actuator backend and the hardware the feature
+ * switches in config.hpp depend on.
+ *
+ */
+#ifndef VEHICLE_PROFILES_HPP_
+#define VEHICLE_PROFILES_HPP_
+
+#include <cstddef>
+
+namespace tritonai {
+namespace gkc {
+// One row of the steering map, both in radians
+struct SteerPoint {
+  float motor;
+  float steer;
+};
+
+struct VehicleProfile {
+  const char *name;
+  // Geometry
+  float wheelbase_m;
+  float wheel_circumference_m;
+  float motor_pole_pairs;
+  float drive_gear_ratio; // motor turns per wheel turn
+  // Limits, in m/s and road wheel degrees
+  float max_forward_speed_ms;
+  float max_reverse_speed_ms;
+  float rc_max_forward_speed_ms;
+  float rc_max_reverse_speed_ms;
+  float max_wheel_steer_deg; // both sides
+  // Steering: road wheel angle to motor angle, one side, mirrored for the
+  // other, and the actuator position of the center until it is calibrated
+  const SteerPoint *steering_map;
+  size_t steering_map_size;
+  float steer_motor_offset;
+};
+
+// motor angle - left wheel - right wheel - average (in degrees)
+// 0	0	0	0
+// 30	8	10	9
+// 50	9	15	12
+// 70	12	22	17
+// 80	10	30	20
+// 90           23
+// 100          26
+// 110          29
+constexpr SteerPoint KART_STEERING_MAP[] = {{0, 0},
+                                            {0.523599, 0.15708},
+                                            {0.872665, 0.20944},
+                                            {1.22173, 0.296706},
+                                            {1.39626, 0.349066},
+                                            {1.57079, 0.401425},
+                                            {1.74532, 0.453785},
+                                            {1.91986, 0.506145}};
+
+constexpr VehicleProfile KART_PROFILE{
+    "kart",
+    1.05, 0.85, 5.0, 59.0 / 22.0,
+    20.0, 20.0, 20.0, 5.0, 20.0,
+    KART_STEERING_MAP,
+    sizeof(KART_STEERING_MAP) / sizeof(KART_STEERING_MAP[0]),
+    0.3};
+
+// 1/10 scale: the servo turns the wheels directly
+constexpr SteerPoint RC_CAR_STEERING_MAP[] = {{0, 0}, {0.5, 0.5}};
+
+constexpr VehicleProfile RC_CAR_PROFILE{
+    "rc_car",
+    0.26, 0.345, 2.0, 8.0,
+    5.0, 2.0, 3.0, 1.0, 25.0,
+    RC_CAR_STEERING_MAP,
+    sizeof(RC_CAR_STEERING_MAP) / sizeof(RC_CAR_STEERING_MAP[0]),
+    0.0};
+
+constexpr float DEG_PER_RAD = 57.2957795f;
+
+constexpr bool is_consistent(const VehicleProfile &p) {
+  return p.wheelbase_m > 0.0f && p.wheel_circumference_m > 0.0f &&
+         p.motor_pole_pairs >= 1.0f && p.drive_gear_ratio > 0.0f &&
+         p.max_forward_speed_ms > 0.0f && p.max_reverse_speed_ms > 0.0f &&
+         p.rc_max_forward_speed_ms <= p.max_forward_speed_ms &&
+         p.rc_max_reverse_speed_ms <= p.max_reverse_speed_ms &&
+         p.steering_map_size >= 2 &&
+         // the map must reach the steering range, or the ends are clipped
+         p.steering_map[p.steering_map_size - 1].steer * DEG_PER_RAD >=
+             p.max_wheel_steer_deg;
+}
+static_assert(is_consistent(KART_PROFILE), "inconsistent kart profile");
+static_assert(is_consistent(RC_CAR_PROFILE), "inconsistent RC car profile");
+
+#if defined(VEHICLE_PROFILE_RC_CAR)
+constexpr VehicleProfile VEHICLE = RC_CAR_PROFILE;
+#else
+constexpr VehicleProfile VEHICLE = KART_PROFILE;
+#endif
+} // namespace gkc
+} // namespace tritonai
+
+// Hardware of the profile, for the preprocessor
+#if defined(VEHICLE_PROFILE_RC_CAR)
+#if defined(VEHICLE_PROFILE_KART)
+#error "more than one VEHICLE_PROFILE_* is defined"
+#endif
+#ifndef ACTUATOR_SIM
+#define ACTUATOR_PWM // steering servo and ESC on Steer_Pin and Throttle_Pin
+#endif
+#else
+#ifndef VEHICLE_PROFILE_KART
+#define VEHICLE_PROFILE_KART
+#endif
+#define VEHICLE_HAS_RACK_SWITCHES // LEFT_LSWITCH and RIGHT_LSWITCH on the rack
+#define VEHICLE_HAS_BRAKE_ACTUATOR // brake actuator on CAN, reporting its position
+#endif
+
+#endif // VEHICLE_PROFILES_HPP_
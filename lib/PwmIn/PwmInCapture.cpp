@@ -0,0 +1,241 @@
+/* mbed PwmIn Library, timer input capture backend
+ *
+ * Same interface as PwmIn, measured by hardware instead of InterruptIn.
+ */
+
+#include "PwmInCapture.h"
+#include "PeripheralPins.h"
+#include "pinmap.h"
+
+PwmInCapture *PwmInCapture::_instances[PwmInCapture::MAX_INSTANCES] = {};
+
+// Clock of the timer kernel: the APB clock, doubled when the APB prescaler
+// is not 1. TIM1/TIM8 sit on APB2, the others used here on APB1.
+static uint32_t timer_clock_hz(TIM_TypeDef *tim) {
+    RCC_ClkInitTypeDef clk;
+    uint32_t latency;
+    HAL_RCC_GetClockConfig(&clk, &latency);
+    if (tim == TIM1 || tim == TIM8) {
+        uint32_t pclk = HAL_RCC_GetPCLK2Freq();
+        return clk.APB2CLKDivider == RCC_APB2_DIV1 ? pclk : 2 * pclk;
+    }
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    return clk.APB1CLKDivider == RCC_APB1_DIV1 ? pclk : 2 * pclk;
+}
+
+// Enables the timer clock and routes its interrupts to PwmInCapture::irq
+static void setup_timer(TIM_TypeDef *tim, void (*handler)()) {
+    IRQn_Type irqs[2];
+    int num_irqs = 0;
+    if (tim == TIM1) {
+        __HAL_RCC_TIM1_CLK_ENABLE();
+        irqs[num_irqs++] = TIM1_CC_IRQn;
+        irqs[num_irqs++] = TIM1_UP_IRQn;
+    } else if (tim == TIM2) {
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        irqs[num_irqs++] = TIM2_IRQn;
+    } else if (tim == TIM3) {
+        __HAL_RCC_TIM3_CLK_ENABLE();
+        irqs[num_irqs++] = TIM3_IRQn;
+    } else if (tim == TIM4) {
+        __HAL_RCC_TIM4_CLK_ENABLE();
+        irqs[num_irqs++] = TIM4_IRQn;
+    } else if (tim == TIM8) {
+        __HAL_RCC_TIM8_CLK_ENABLE();
+        irqs[num_irqs++] = TIM8_CC_IRQn;
+        irqs[num_irqs++] = TIM8_UP_TIM13_IRQn;
+    } else {
+        error("PwmInCapture: unsupported timer\r\n");
+    }
+    for (int i = 0; i < num_irqs; i++) {
+        NVIC_SetVector(irqs[i], (uint32_t)handler);
+        NVIC_EnableIRQ(irqs[i]);
+    }
+}
+
+PwmInCapture::PwmInCapture(PinName p) : _seq(0), _count(0), _next(0) {
+    _tim = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+    const int channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+    MBED_ASSERT(channel == 1 || channel == 2);
+    pinmap_pinout(p, PinMap_PWM);
+
+    core_util_critical_section_enter();
+    for (int i = 0; i < MAX_INSTANCES; i++) {
+        if (_instances[i] == NULL) {
+            _instances[i] = this;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    const uint32_t prescaler = timer_clock_hz(_tim) / PWMIN_CAPTURE_TICK_HZ;
+    _tick_hz = timer_clock_hz(_tim) / prescaler;
+
+    TIM_HandleTypeDef handle = {};
+    handle.Instance = _tim;
+    handle.Init.Prescaler = prescaler - 1;
+    handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    handle.Init.Period = 0xFFFF;
+    handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    handle.Init.RepetitionCounter = 0;
+    handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+    // PWM input mode: the pin's own channel latches the period on the
+    // rising edge, the other channel the pulse width on the falling edge of
+    // the same input, and the rising edge resets the counter.
+    const uint32_t period_channel = channel == 1 ? TIM_CHANNEL_1 : TIM_CHANNEL_2;
+    const uint32_t width_channel = channel == 1 ? TIM_CHANNEL_2 : TIM_CHANNEL_1;
+    _period_flag = channel == 1 ? TIM_SR_CC1IF : TIM_SR_CC2IF;
+    _period_ccr = channel == 1 ? &_tim->CCR1 : &_tim->CCR2;
+    _width_ccr = channel == 1 ? &_tim->CCR2 : &_tim->CCR1;
+
+    TIM_IC_InitTypeDef ic = {};
+    ic.ICPolarity = TIM_ICPOLARITY_RISING;
+    ic.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    ic.ICPrescaler = TIM_ICPSC_DIV1;
+    ic.ICFilter = 0;
+    TIM_IC_InitTypeDef ic_width = ic;
+    ic_width.ICPolarity = TIM_ICPOLARITY_FALLING;
+    ic_width.ICSelection = TIM_ICSELECTION_INDIRECTTI;
+
+    TIM_SlaveConfigTypeDef slave = {};
+    slave.SlaveMode = TIM_SLAVEMODE_RESET;
+    slave.InputTrigger = channel == 1 ? TIM_TS_TI1FP1 : TIM_TS_TI2FP2;
+    slave.TriggerPolarity = TIM_TRIGGERPOLARITY_RISING;
+    slave.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+    slave.TriggerFilter = 0;
+
+    setup_timer(_tim, &PwmInCapture::irq);
+    if (HAL_TIM_IC_Init(&handle) != HAL_OK ||
+        HAL_TIM_IC_ConfigChannel(&handle, &ic, period_channel) != HAL_OK ||
+        HAL_TIM_IC_ConfigChannel(&handle, &ic_width, width_channel) != HAL_OK ||
+        HAL_TIM_SlaveConfigSynchro(&handle, &slave) != HAL_OK) {
+        error("PwmInCapture: failed to configure input capture\r\n");
+    }
+
+    // Only a counter overflow (no rising edge for a whole counter range)
+    // should raise the update interrupt, not the slave mode reset.
+    _tim->CR1 |= TIM_CR1_URS;
+    _tim->DIER |= (channel == 1 ? TIM_DIER_CC1IE : TIM_DIER_CC2IE) | TIM_DIER_UIE;
+    HAL_TIM_IC_Start(&handle, width_channel);
+    HAL_TIM_IC_Start(&handle, period_channel);
+}
+
+float PwmInCapture::period() {
+    uint32_t period_ticks, width_ticks;
+    if (!readTicks(period_ticks, width_ticks)) {
+        return 0.0;
+    }
+    return (float)period_ticks / _tick_hz;
+}
+
+float PwmInCapture::pulsewidth() {
+    uint32_t period_ticks, width_ticks;
+    if (!readTicks(period_ticks, width_ticks)) {
+        return 0.0;
+    }
+    return (float)width_ticks / _tick_hz;
+}
+
+// Insertion sort of a handful of values, returns the middle one
+template <typename T>
+static T median(T *values, uint32_t n) {
+    for (uint32_t i = 1; i < n; i++) {
+        T v = values[i];
+        uint32_t j = i;
+        for (; j > 0 && values[j - 1] > v; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = v;
+    }
+    return values[n / 2];
+}
+
+float PwmInCapture::dutycycle() {
+    Sample samples[PWMIN_MEDIAN_WINDOW];
+    const uint32_t n = snapshot(samples);
+    if (n == 0) {
+        return 0.0;
+    }
+    // Median of the per pulse ratios: period jitter cancels within a pulse
+    float duty[PWMIN_MEDIAN_WINDOW];
+    for (uint32_t i = 0; i < n; i++) {
+        duty[i] = (float)samples[i].pulsewidth / samples[i].period;
+    }
+    return median(duty, n);
+}
+
+bool PwmInCapture::readTicks(uint32_t &periodTicks, uint32_t &pulsewidthTicks) {
+    Sample samples[PWMIN_MEDIAN_WINDOW];
+    const uint32_t n = snapshot(samples);
+    if (n == 0) {
+        return false;
+    }
+    uint16_t periods[PWMIN_MEDIAN_WINDOW];
+    uint16_t widths[PWMIN_MEDIAN_WINDOW];
+    for (uint32_t i = 0; i < n; i++) {
+        periods[i] = samples[i].period;
+        widths[i] = samples[i].pulsewidth;
+    }
+    periodTicks = median(periods, n);
+    pulsewidthTicks = median(widths, n);
+    return true;
+}
+
+uint32_t PwmInCapture::snapshot(Sample *samples) {
+    uint32_t seq, count;
+    do {
+        seq = _seq;
+        __DMB();
+        count = _count;
+        memcpy(samples, _history, sizeof(_history));
+        __DMB();
+        // The interrupt always completes an update before we run again, so
+        // an odd or changed sequence just means "copy again".
+    } while ((seq & 1) || seq != _seq);
+    return count;
+}
+
+void PwmInCapture::capture() {
+    const uint32_t sr = _tim->SR;
+
+    if (sr & TIM_SR_UIF) {
+        // A full counter range without a rising edge: the signal is gone,
+        // forget the history so stale pulses are not reported.
+        _tim->SR = ~TIM_SR_UIF;
+        _seq++;
+        __DMB();
+        _count = 0;
+        _next = 0;
+        __DMB();
+        _seq++;
+    }
+
+    if (sr & _period_flag) {
+        // Reading the capture registers clears their flags. The width
+        // register holds the falling edge of the pulse that just ended.
+        const uint32_t period = *_period_ccr;
+        const uint32_t width = *_width_ccr;
+        if (period == 0 || width > period) {
+            return;
+        }
+        _seq++;
+        __DMB();
+        _history[_next].period = period;
+        _history[_next].pulsewidth = width;
+        _next = (_next + 1) % PWMIN_MEDIAN_WINDOW;
+        if (_count < PWMIN_MEDIAN_WINDOW) {
+            _count++;
+        }
+        __DMB();
+        _seq++;
+    }
+}
+
+void PwmInCapture::irq() {
+    for (int i = 0; i < MAX_INSTANCES; i++) {
+        if (_instances[i] != NULL) {
+            _instances[i]->capture();
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/* mbed PwmIn Library, timer input capture backend
+ *
+ * Same interface as PwmIn, measured by hardware instead of InterruptIn.
+ */
+
+#ifndef MBED_PWMIN_CAPTURE_H
+#define MBED_PWMIN_CAPTURE_H
+
+#include "mbed.h"
+
+// Number of pulses the median filter runs over, odd
+#ifndef PWMIN_MEDIAN_WINDOW
+#define PWMIN_MEDIAN_WINDOW 5
+#endif
+// Resolution of the capture timer
+#ifndef PWMIN_CAPTURE_TICK_HZ
+#define PWMIN_CAPTURE_TICK_HZ 10000000
+#endif
+
+/** PwmInCapture class to read PWM inputs with a hardware timer
+ *
+ * Runs the timer of the pin in PWM input mode: a rising edge latches the
+ * period and resets the counter, a falling edge latches the pulse width.
+ * Both are measured in timer ticks by hardware, so interrupt latency does
+ * not affect them. The capture interrupt only copies the latched values into
+ * a small history, guarded by a sequence counter so that readers in any
+ * thread get a consistent snapshot without locking.
+ *
+ * Readings are the median over the last PWMIN_MEDIAN_WINDOW pulses.
+ *
+ * @note the pin must be channel 1 or 2 of a timer (see PinMap_PWM), and
+ * a period must fit in the 16 bit counter at PWMIN_CAPTURE_TICK_HZ
+ * (6.5 ms at 10 MHz). Longer gaps are reported as signal loss.
+ */
+class PwmInCapture {
+public:
+    /** Create a PwmInCapture
+     *
+     * @param p The pwm input pin (must be timer channel 1 or 2)
+     */
+    PwmInCapture(PinName p);
+
+    /** Read the current period
+     *
+     * @returns the period in seconds, 0 if there is no signal
+     */
+    float period();
+
+    /** Read the current pulsewidth
+     *
+     * @returns the pulsewidth in seconds, 0 if there is no signal
+     */
+    float pulsewidth();
+
+    /** Read the current dutycycle
+     *
+     * @returns the dutycycle as a percentage, represented between 0.0-1.0
+     */
+    float dutycycle();
+
+    /** Read the median period and pulsewidth in timer ticks
+     *
+     * @param periodTicks     median period
+     * @param pulsewidthTicks median pulsewidth
+     * @returns false if no complete pulse was seen since the signal was lost
+     */
+    bool readTicks(uint32_t &periodTicks, uint32_t &pulsewidthTicks);
+
+    /** Timer ticks per second */
+    uint32_t tickHz() const { return _tick_hz; }
+
+protected:
+    struct Sample {
+        uint16_t period;
+        uint16_t pulsewidth;
+    };
+
+    // Copies the history, retrying while the capture interrupt updates it.
+    // Returns the number of valid samples.
+    uint32_t snapshot(Sample *samples);
+    void capture();
+    static void irq();
+
+    TIM_TypeDef *_tim;
+    uint32_t _tick_hz;
+    uint32_t _period_flag;      // capture flag of the channel latching the period
+    volatile uint32_t *_period_ccr;
+    volatile uint32_t *_width_ccr;
+
+    Sample _history[PWMIN_MEDIAN_WINDOW];
+    volatile uint32_t _seq;     // odd while the history is being written
+    volatile uint32_t _count;   // valid samples in the history
+    uint32_t _next;             // next history slot to write
+
+    static const int MAX_INSTANCES = 4;
+    static PwmInCapture *_instances[MAX_INSTANCES];
+};
+
+#endif
@@ -127,6 +127,7 @@
  * Includes
  */
 #include "QEI.hpp"
+#include "hal/us_ticker_api.h"
 
 QEI::QEI(PinName channelA,
          PinName channelB,
@@ -137,6 +138,9 @@ QEI::QEI(PinName channelA,
 
     pulses_       = 0;
     revolutions_  = 0;
+    lastPulseUs_  = 0;
+    periodUs_     = 0;
+    lastDirection_ = 0;
     pulsesPerRev_ = pulsesPerRev;
     encoding_     = encoding;
     
@@ -171,6 +175,8 @@ void QEI::reset(void) {
 
     pulses_      = 0;
     revolutions_ = 0;
+    periodUs_    = 0;
+    lastDirection_ = 0;
 
 }
 
@@ -186,6 +192,35 @@ int QEI::getPulses(void) {
 
 }
 
+void QEI::getPulseTiming(int &pulses, uint32_t &lastPulseUs, int32_t &periodUs) {
+
+    //encode() runs in interrupt context, keep the three values coherent.
+    core_util_critical_section_enter();
+    pulses      = pulses_;
+    lastPulseUs = lastPulseUs_;
+    periodUs    = periodUs_;
+    core_util_critical_section_exit();
+
+}
+
+void QEI::stampPulse(int direction) {
+
+    uint32_t now    = us_ticker_read();
+    uint32_t period = now - lastPulseUs_;
+
+    if (period > INT32_MAX) {
+        period = INT32_MAX;
+    }
+    //A direction change (or the first pulse) restarts the period measurement.
+    if (lastDirection_ == direction) {
+        periodUs_ = direction > 0 ? (int32_t)period : -(int32_t)period;
+    } else {
+        periodUs_ = 0;
+    }
+    lastDirection_ = direction;
+    lastPulseUs_   = now;
+
+}
 
 // +-------------+
 // | X2 Encoding |
@@ -247,6 +282,7 @@ void QEI::encode(void) {
                 (prevState_ == 0x0 && currState_ == 0x3)) {
 
             pulses_++;
+            stampPulse(1);
 
         }
         //10->01->10->01 is clockwise rotation or "backward".
@@ -254,6 +290,7 @@ void QEI::encode(void) {
                  (prevState_ == 0x1 && currState_ == 0x2)) {
 
             pulses_--;
+            stampPulse(-1);
 
         }
 
@@ -270,6 +307,7 @@ void QEI::encode(void) {
             }
 
             pulses_ -= change;
+            stampPulse(-change);
         }
     }
     prevState_ = currState_;
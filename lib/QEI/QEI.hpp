@@ -201,6 +201,18 @@ public:
      */
     int getPulses(void);
 
+    /**
+     * Read the pulse count together with the timing of the last pulses,
+     * consistently with each other, for period based velocity estimation.
+     *
+     * @param pulses      Number of pulses which have occured.
+     * @param lastPulseUs us_ticker time of the last pulse in microseconds.
+     * @param periodUs    Time between the last two pulses in microseconds,
+     *                    negative when the last pulse was backward,
+     *                    0 if fewer than two pulses were seen.
+     */
+    void getPulseTiming(int &pulses, uint32_t &lastPulseUs, int32_t &periodUs);
+
     /**
      * Read the number of revolutions recorded by the encoder on the index channel.
      *
@@ -253,6 +265,15 @@ private:
     
     volatile int pulses_;            // keeps track of how many pulses have happened from initializing position
     volatile int revolutions_;       // keeps track of how many revolutions have happened from initializing position
+    volatile uint32_t lastPulseUs_;  // us_ticker time of the last pulse
+    volatile int32_t periodUs_;      // signed time between the last two pulses, 0 if unknown
+    int          lastDirection_;     // direction of the last pulse, 0 before the first one
+
+    /**
+     * Record the time of a pulse, called from encode() with the direction
+     * of the pulse.
+     */
+    void stampPulse(int direction);
 
 };
 
@@ -0,0 +1,219 @@
+/**
+ * Includes
+ */
+#include "QEITimer.hpp"
+#include "PeripheralPins.h"
+#include "pinmap.h"
+#include "hal/us_ticker_api.h"
+
+//Digital filter applied to both inputs, in timer clock cycles (0x0-0xF).
+#define QEI_TIMER_INPUT_FILTER 0x6
+
+static void enableTimerClock(TIM_TypeDef *tim) {
+
+#if defined(TIM1)
+    if (tim == TIM1) { __HAL_RCC_TIM1_CLK_ENABLE(); }
+#endif
+#if defined(TIM2)
+    if (tim == TIM2) { __HAL_RCC_TIM2_CLK_ENABLE(); }
+#endif
+#if defined(TIM3)
+    if (tim == TIM3) { __HAL_RCC_TIM3_CLK_ENABLE(); }
+#endif
+#if defined(TIM4)
+    if (tim == TIM4) { __HAL_RCC_TIM4_CLK_ENABLE(); }
+#endif
+#if defined(TIM5)
+    if (tim == TIM5) { __HAL_RCC_TIM5_CLK_ENABLE(); }
+#endif
+#if defined(TIM8)
+    if (tim == TIM8) { __HAL_RCC_TIM8_CLK_ENABLE(); }
+#endif
+
+}
+
+QEITimer::QEITimer(PinName channelA,
+                   PinName channelB,
+                   PinName index,
+                   int pulsesPerRev,
+                   QEI::Encoding encoding) : index_(index) {
+
+    pulses_        = 0;
+    revolutions_   = 0;
+    lastPulseUs_   = 0;
+    periodUs_      = 0;
+    lastDirection_ = 0;
+    oldDistance_   = 0;
+    newDistance_   = 0;
+    velocity_      = 0;
+    pulsesPerRev_  = pulsesPerRev;
+    encoding_      = encoding;
+
+    ti.start();
+
+    //Both channels must be channel 1 and 2 of the same timer.
+    TIM_TypeDef *timA = (TIM_TypeDef *)pinmap_peripheral(channelA, PinMap_PWM);
+    TIM_TypeDef *timB = (TIM_TypeDef *)pinmap_peripheral(channelB, PinMap_PWM);
+    MBED_ASSERT(timA == timB);
+    MBED_ASSERT(STM_PIN_CHANNEL(pinmap_function(channelA, PinMap_PWM)) == 1);
+    MBED_ASSERT(STM_PIN_CHANNEL(pinmap_function(channelB, PinMap_PWM)) == 2);
+
+    //Route the pins to the timer, pulled up for open collector encoders.
+    pinmap_pinout(channelA, PinMap_PWM);
+    pinmap_pinout(channelB, PinMap_PWM);
+    pin_mode(channelA, PullUp);
+    pin_mode(channelB, PullUp);
+    portA_ = Set_GPIO_Clock(STM_PORT(channelA));
+    portB_ = Set_GPIO_Clock(STM_PORT(channelB));
+    pinA_  = STM_PIN(channelA);
+    pinB_  = STM_PIN(channelB);
+
+    enableTimerClock(timA);
+    counterMask_ = IS_TIM_32B_COUNTER_INSTANCE(timA) ? 0xFFFFFFFF : 0xFFFF;
+
+    timer_.Instance               = timA;
+    timer_.Init.Prescaler         = 0;
+    timer_.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    timer_.Init.Period            = counterMask_;
+    timer_.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    timer_.Init.RepetitionCounter = 0;
+    timer_.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+    //X2 encoding counts both edges of TI1 only, X4 both edges of TI1 and TI2.
+    TIM_Encoder_InitTypeDef config = {0};
+    config.EncoderMode  = encoding == QEI::X4_ENCODING ? TIM_ENCODERMODE_TI12
+                                                       : TIM_ENCODERMODE_TI1;
+    config.IC1Polarity  = TIM_ICPOLARITY_RISING;
+    config.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+    config.IC1Prescaler = TIM_ICPSC_DIV1;
+    config.IC1Filter    = QEI_TIMER_INPUT_FILTER;
+    config.IC2Polarity  = TIM_ICPOLARITY_RISING;
+    config.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+    config.IC2Prescaler = TIM_ICPSC_DIV1;
+    config.IC2Filter    = QEI_TIMER_INPUT_FILTER;
+
+    if (HAL_TIM_Encoder_Init(&timer_, &config) != HAL_OK ||
+            HAL_TIM_Encoder_Start(&timer_, TIM_CHANNEL_ALL) != HAL_OK) {
+        error("QEITimer: failed to start encoder mode\r\n");
+    }
+    lastCount_ = timer_.Instance->CNT;
+
+    //Index is optional.
+    if (index != NC) {
+        index_.rise(callback(this, &QEITimer::index));
+    }
+
+}
+
+void QEITimer::reset(void) {
+
+    core_util_critical_section_enter();
+    lastCount_     = timer_.Instance->CNT;
+    pulses_        = 0;
+    revolutions_   = 0;
+    periodUs_      = 0;
+    lastDirection_ = 0;
+    core_util_critical_section_exit();
+
+}
+
+int QEITimer::getCurrentState(void) {
+
+    int chanA = (portA_->IDR >> pinA_) & 0x1;
+    int chanB = (portB_->IDR >> pinB_) & 0x1;
+
+    return (chanA << 1) | (chanB);
+
+}
+
+int QEITimer::getPulses(void) {
+
+    update();
+    return pulses_;
+
+}
+
+void QEITimer::getPulseTiming(int &pulses, uint32_t &lastPulseUs, int32_t &periodUs) {
+
+    core_util_critical_section_enter();
+    update();
+    pulses      = pulses_;
+    lastPulseUs = lastPulseUs_;
+    periodUs    = periodUs_;
+    core_util_critical_section_exit();
+
+}
+
+// The counter wraps at counterMask_. Interpreting the difference to the last
+// read as a signed number of the counter's width recovers the true change as
+// long as less than half the range has been counted in between.
+void QEITimer::update(void) {
+
+    core_util_critical_section_enter();
+
+    uint32_t count = timer_.Instance->CNT;
+    uint32_t diff  = (count - lastCount_) & counterMask_;
+    int32_t  delta = counterMask_ == 0xFFFF ? (int16_t)diff : (int32_t)diff;
+    lastCount_ = count;
+
+    //In TI12 mode the timer counts up when channel A leads, which QEI counts
+    //as backward, so its count is negated.
+    delta = -delta;
+
+    if (delta != 0) {
+        int direction   = delta > 0 ? 1 : -1;
+        uint32_t now    = us_ticker_read();
+        uint32_t period = (now - lastPulseUs_) / (uint32_t)(delta * direction);
+
+        if (period > INT32_MAX) {
+            period = INT32_MAX;
+        }
+        //A direction change (or the first change) restarts the measurement.
+        if (lastDirection_ == direction) {
+            periodUs_ = direction > 0 ? (int32_t)period : -(int32_t)period;
+        } else {
+            periodUs_ = 0;
+        }
+        pulses_       += delta;
+        lastDirection_ = direction;
+        lastPulseUs_   = now;
+    }
+
+    core_util_critical_section_exit();
+
+}
+
+float QEITimer::getRevolutions(void) {
+
+    int pulses = getPulses();
+
+    if (encoding_ == QEI::X2_ENCODING) {
+        return (float)pulses / pulsesPerRev_;
+    } else {
+        return (float)pulses / (4 * pulsesPerRev_);
+    }
+
+}
+
+float QEITimer::getDistance(float diameter) {
+
+    oldDistance_ = newDistance_;
+    newDistance_ = getRevolutions()*diameter*3.1415926;
+    return newDistance_;
+
+}
+
+void QEITimer::index(void) {
+
+    revolutions_++;
+
+}
+
+float QEITimer::getVelocity() {
+
+    getDistance(53.975);
+    velocity_ = (newDistance_-oldDistance_)/(ti.read()*1000);
+    ti.reset();
+    return velocity_;
+
+}
@@ -0,0 +1,147 @@
+/**
+ * @section DESCRIPTION
+ *
+ * Quadrature Encoder Interface backed by an STM32 general purpose or advanced
+ * timer in encoder mode.
+ *
+ * The timer decodes the A/B channels in hardware and counts up or down on
+ * every edge, so no interrupt runs per pulse and no pulse is lost at high
+ * speed. The hardware counter is 16 or 32 bits wide; it is extended in
+ * software to a full int on every read, which only requires reading the
+ * encoder at least once per half counter range (32768 pulses on a 16 bit
+ * timer).
+ *
+ * The public API matches QEI, so either class can be used as the encoder
+ * type of a sensor provider.
+ *
+ * Channel A must be wired to channel 1 and channel B to channel 2 of the
+ * same timer, e.g. PE_9/PE_11 for TIM1.
+ *
+ * Since edges are not timestamped individually, the pulse timing reported by
+ * getPulseTiming() is taken when the counter is found to have changed; its
+ * resolution is the interval between two reads.
+ */
+
+#ifndef QEI_TIMER_H
+#define QEI_TIMER_H
+
+/**
+ * Includes
+ */
+#include "mbed.h"
+#include "QEI.hpp"
+
+/**
+ * Quadrature Encoder Interface using a hardware timer.
+ */
+class QEITimer {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * Configures the timer of channel A/B in encoder mode and starts it.
+     *
+     * @param channelA mbed pin for channel A input (timer channel 1).
+     * @param channelB mbed pin for channel B input (timer channel 2).
+     * @param index    mbed pin for optional index channel input,
+     *                 (pass NC if not needed).
+     * @param pulsesPerRev Number of pulses in one revolution.
+     * @param encoding The encoding to use. X2 counts both edges of channel A,
+     *                 X4 counts both edges of both channels.
+     */
+    QEITimer(PinName channelA, PinName channelB, PinName index, int pulsesPerRev, QEI::Encoding encoding = QEI::X2_ENCODING);
+
+    /**
+     * Reset the encoder.
+     *
+     * Sets the pulses and revolutions count to zero.
+     */
+    void reset(void);
+
+    /**
+     * Read the state of the encoder.
+     *
+     * @return The current state of the encoder as a 2-bit number, where:
+     *         bit 1 = The reading from channel B
+     *         bit 2 = The reading from channel A
+     */
+    int getCurrentState(void);
+
+    /**
+     * Read the number of pulses recorded by the encoder.
+     *
+     * @return Number of pulses which have occured.
+     */
+    int getPulses(void);
+
+    /**
+     * Read the pulse count together with the timing of the last pulses.
+     *
+     * @param pulses      Number of pulses which have occured.
+     * @param lastPulseUs us_ticker time the counter was last seen changing.
+     * @param periodUs    Time per pulse over the last observed change,
+     *                    negative when counting backward, 0 if unknown.
+     */
+    void getPulseTiming(int &pulses, uint32_t &lastPulseUs, int32_t &periodUs);
+
+    /**
+     * Read the number of revolutions recorded by the encoder.
+     *
+     * @return Number of revolutions which have occured.
+     */
+    float getRevolutions(void);
+
+    /**
+     * Takes the difference of distance divided by the difference of time
+     */
+    float getVelocity();
+
+    /**
+     * Calculates the distance travelled using the diameter of the wheel and how many revolutions have happened
+     */
+    float getDistance(float diameter);
+
+private:
+
+    /**
+     * Fold the hardware counter into the extended pulse count and update
+     * the pulse timing. Must run at least once per half counter range.
+     */
+    void update(void);
+
+    /**
+     * Called on every rising edge of channel index to update revolution
+     * count by one.
+     */
+    void index(void);
+
+    QEI::Encoding encoding_;
+
+    TIM_HandleTypeDef timer_;        // timer running in encoder mode
+    uint32_t     counterMask_;       // 0xFFFF or 0xFFFFFFFF
+    uint32_t     lastCount_;         // raw counter value at the last update
+    GPIO_TypeDef *portA_;            // ports and pin numbers of the channels,
+    GPIO_TypeDef *portB_;            // for getCurrentState()
+    uint32_t     pinA_;
+    uint32_t     pinB_;
+
+    InterruptIn  index_;
+
+    float        pulsesPerRev_;      // variable that keeps the pulses in each revolution
+    float        oldDistance_;       // variable that keeps distance initial for velocity calculation
+    float        newDistance_;       // variable that keeps distance final for velocity calculation
+    float        velocity_;          // variable with the current velocity
+
+    Timer ti;                        // timer to keep track of time for getVelocity()
+
+    int          pulses_;            // extended pulse count since the last reset
+    uint32_t     lastPulseUs_;       // us_ticker time the counter was last seen changing
+    int32_t      periodUs_;          // signed time per pulse over the last change
+    int          lastDirection_;     // direction of the last change, 0 before the first one
+    volatile int revolutions_;       // keeps track of how many revolutions have happened from initializing position
+
+};
+
+#endif /* QEI_TIMER_H */
@@ -1,33 +1,384 @@
 #include "Actuation/actuation_controller.hpp"
 #include "Tools/logger.hpp"
-#include "Actuation/vesc_can_tools.hpp"
+#include "Actuation/brake_map.hpp"
+#include "Actuation/steering_map.hpp"
+#include "Tools/timebase.hpp"
 #include "config.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace tritonai::gkc
 {
-  ActuationController::ActuationController(ILogger *logger) : logger(logger)
+  namespace
   {
+    constexpr float ERPM_TO_MS = WHEEL_CIRCUMFERENCE_M / (MOTOR_POLE_PAIRS * DRIVE_GEAR_RATIO * 60.0f);
+    constexpr float LOOP_PERIOD_S = PID_INTERVAL_MS / 1000.0f;
+    constexpr float DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+  }
+
+  ActuationController::ActuationController(ILogger *logger, VehicleActuator *actuator) :
+    logger(logger), actuator_(actuator)
+#ifdef ENABLE_LSWITCH
+    , limits_(callback(this, &ActuationController::steering_limit_hit))
+#endif
+  {
+#ifdef ACTUATION_CONTROL_LOOP
+    control_thread_.start(callback(this, &ActuationController::control_thread_impl));
+#endif
   }
 
   void ActuationController::set_throttle_cmd(float cmd)
   {
-    cmd = ActuationController::clamp(cmd, THROTTLE_MAX_REVERSE_SPEED, -1.0f*THROTTLE_MAX_REVERSE_SPEED);
-    comm_can_set_speed(cmd);
+    cmd = ActuationController::clamp(cmd, THROTTLE_MAX_FORWARD_SPEED, -1.0f*THROTTLE_MAX_REVERSE_SPEED);
+#ifdef ENABLE_SPEED_LOOP
+    // The control thread sends it on its next tick
+    throttle_cmd_ = cmd;
+    speed_armed_ = true;
+#else
+    actuator_->set_speed(cmd);
+#endif
   }
 
   void ActuationController::full_rel_rev_current_brake()
   {
-    comm_can_set_current_brake_rel(THROTTLE_CAN_ID, 1.0);
+#ifdef ENABLE_SPEED_LOOP
+    // Stop the speed loop first, or its next RPM command ends the braking
+    speed_armed_ = false;
+#endif
+    actuator_->set_drive_brake(1.0f);
+  }
+
+  void ActuationController::emergency_stop()
+  {
+#ifdef ENABLE_SPEED_LOOP
+    speed_armed_ = false;
+#endif
+    actuator_->stop_all();
   }
 
   void ActuationController::set_steering_cmd(float cmd)
   {
-    comm_can_set_angle(cmd);
+#ifdef ENABLE_STEER_PID
+    // The control thread sends it on its next tick
+    steering_cmd_ = cmd;
+    steering_armed_ = true;
+#else
+    if (!steering_calibrating_) {
+      send_steering_angle(cmd);
+    }
+#endif
+  }
+
+  float ActuationController::limit_motor_angle(float motor_angle)
+  {
+    motor_angle = clamp(motor_angle, calibration_.left_limit, calibration_.right_limit);
+#ifdef ENABLE_LSWITCH
+    // At a closed switch, only travel away from it is allowed
+    const bool encoder_valid = steer_encoder_ && steer_encoder_->is_ready();
+    const float angle = encoder_valid ? steer_encoder_->get_angle() : last_motor_angle_;
+    if (limits_.left_blocked() && motor_angle > angle) {
+      motor_angle = angle;
+    }
+    if (limits_.right_blocked() && motor_angle < angle) {
+      motor_angle = angle;
+    }
+#endif
+    return motor_angle;
+  }
+
+  void ActuationController::send_steering_angle(float steering)
+  {
+    last_motor_angle_ = limit_motor_angle(map_steer2motor(steering));
+    actuator_->set_steer_angle(last_motor_angle_ + calibration_.motor_offset);
+  }
+
+#ifdef ENABLE_LSWITCH
+  void ActuationController::steering_limit_hit()
+  {
+    // The next command that still pushes into the switch is clamped
+    actuator_->stop_steering();
   }
+#endif
+
+  bool ActuationController::calibrate_steering()
+  {
+#ifdef ENABLE_STEERING_CALIB
+    if (!actuator_->has_steer_current()) {
+      logger->send_log(LogPacket::Severity::WARNING, "Steering calibration skipped, the actuator has no current control");
+      return false;
+    }
+    if (!steer_encoder_ || !wait_for_steer_encoder()) {
+      logger->send_log(LogPacket::Severity::WARNING, "Steering calibration skipped, no encoder reading");
+      return false;
+    }
+    steering_calibrating_ = true;
+
+    float left, right, left_pos, right_pos;
+    bool left_pos_valid, right_pos_valid;
+    const bool reached = sweep_to_stop(1.0f, left, left_pos, left_pos_valid) &&
+                         sweep_to_stop(-1.0f, right, right_pos, right_pos_valid);
+    actuator_->set_steer_current(0.0f);
+
+    const float margin = VIRTUAL_LIMIT_OFF * DEG_TO_RAD;
+    const float half_range = (left - right) / 2.0f;
+    bool ok = false;
+    if (!reached) {
+      logger->send_log(LogPacket::Severity::ERROR, "Steering calibration failed, a stop was not reached");
+    } else if (half_range <= margin) {
+      logger->send_log(LogPacket::Severity::ERROR, "Steering calibration failed, the stops are out of order");
+    } else {
+      const float trim = STEERING_CAL_OFF * DEG_TO_RAD;
+      steer_encoder_->set_center((left + right) / 2.0f + trim);
+      calibration_.left_limit = half_range - margin - trim;
+      calibration_.right_limit = -half_range + margin - trim;
+      if (left_pos_valid && right_pos_valid) {
+        // VESC positions wrap at 360 degrees
+        const float span = std::fmod(left_pos - right_pos + 360.0f, 360.0f);
+        calibration_.motor_offset = std::fmod(right_pos + span / 2.0f, 360.0f) * DEG_TO_RAD + trim;
+      }
+      calibration_.valid = true;
+      ok = true;
+      logger->send_log(LogPacket::Severity::INFO,
+                       "Steering calibrated, range +/-" + std::to_string(half_range) +
+                       " rad, VESC center " + std::to_string(calibration_.motor_offset) + " rad");
+    }
+
+    // Back to the center, starting from where the column is now
+    last_motor_angle_ = steer_encoder_->get_angle();
+#ifdef ENABLE_STEER_PID
+    steering_.reset();
+#endif
+    steering_calibrating_ = false;
+    return ok;
+#else
+    return false;
+#endif
+  }
+
+#ifdef ENABLE_STEERING_CALIB
+  bool ActuationController::wait_for_steer_encoder()
+  {
+    // Right after power-up the encoder may not have a first reading yet
+    const auto deadline = Kernel::Clock::now() + std::chrono::milliseconds(STEERING_CALIB_ENCODER_WAIT_MS);
+    while (!steer_encoder_->is_ready()) {
+      if (Kernel::Clock::now() > deadline) {
+        return false;
+      }
+      ThisThread::sleep_for(std::chrono::milliseconds(PID_INTERVAL_MS));
+    }
+    return true;
+  }
+
+  bool ActuationController::sweep_to_stop(float direction, float &angle, float &vesc_pos, bool &vesc_valid)
+  {
+    const auto interval = std::chrono::milliseconds(PID_INTERVAL_MS);
+    const auto deadline = Kernel::Clock::now() + std::chrono::milliseconds(STEERING_CALIB_TIMEOUT_MS);
+    while (!limits_.blocked(direction)) {
+      if (Kernel::Clock::now() > deadline) {
+        actuator_->set_steer_current(0.0f);
+        return false;
+      }
+      // Repeated every tick, the VESC drops a current command that times out
+      actuator_->set_steer_current(direction * STEERING_CALIB_CURRENT / 1000.0f);
+      ThisThread::sleep_for(interval);
+    }
+    actuator_->set_steer_current(0.0f);
+    angle = steer_encoder_->get_raw_angle();
+
+    VescStatus status;
+    vesc_valid = motor_ && motor_->get_status(STEER_CAN_ID, status) &&
+                 now_us() - status.timestamp_us < VESC_STATUS_TIMEOUT_MS * 1000ull;
+    vesc_pos = status.pid_pos;
+    return true;
+  }
+#endif
 
   void ActuationController::set_brake_cmd(float cmd)
   {
-    comm_can_set_brake_position(cmd);
+#ifdef BRAKE_IN_CONTROL_LOOP
+    // The control thread sends it on its next tick
+    brake_demand_ = clamp(cmd, 1.0f, 0.0f);
+    brake_armed_ = true;
+#else
+    actuator_->set_brake_position(brake_cmd_to_position(clamp(cmd, 1.0f, 0.0f)));
+#endif
+  }
+
+  bool ActuationController::measured_speed(float &speed)
+  {
+    VescStatus status;
+    if (!motor_ || !motor_->is_ready() || !motor_->get_status(THROTTLE_CAN_ID, status)) {
+      return false;
+    }
+    speed = wheel_ ? wheel_->get_speed() : status.erpm * ERPM_TO_MS;
+    return true;
+  }
+
+#ifdef ACTUATION_CONTROL_LOOP
+  void ActuationController::control_thread_impl()
+  {
+    // Fixed rate on absolute deadlines, the loops assume a constant period
+    const auto interval = std::chrono::milliseconds(PID_INTERVAL_MS);
+    auto next_wakeup = Kernel::Clock::now();
+    while (true) {
+#ifdef ENABLE_STEER_PID
+      if (steering_armed_ && !steering_calibrating_) {
+        steering_step();
+      }
+#endif
+#ifdef BRAKE_IN_CONTROL_LOOP
+      // Before the speed loop, which yields the drive VESC to regen
+      if (brake_armed_) {
+        brake_step();
+      }
+#endif
+#ifdef ENABLE_SPEED_LOOP
+      if (speed_armed_) {
+        speed_step();
+      } else {
+        speed_running_ = false;
+      }
+#endif
+
+      next_wakeup += interval;
+      const auto now = Kernel::Clock::now();
+      if (next_wakeup < now) {
+        next_wakeup = now;
+      }
+      ThisThread::sleep_until(next_wakeup);
+    }
+  }
+#endif
+
+#ifdef ENABLE_STEER_PID
+  void ActuationController::steering_step()
+  {
+    float steering = steering_cmd_;
+#ifdef ENABLE_SETPOINT_SHAPING
+    // Cap the angle so the lateral acceleration stays in bounds at speed
+    float speed;
+    if (measured_speed(speed) && std::fabs(speed) > SHAPE_STEER_LIMIT_SPEED_MS) {
+      const float limit = std::atan(WHEELBASE_M * SHAPE_STEER_MAX_LAT_ACCEL_MS2 / (speed * speed));
+      steering = clamp(steering, limit, -limit);
+    }
+    steering = steering_shaper_.update(steering, LOOP_PERIOD_S);
+#endif
+    if (!actuator_->has_steer_current() || !steer_encoder_ || !steer_encoder_->is_ready()) {
+      // No feedback: hand the column back to the actuator position loop
+      if (steering_closed_) {
+        logger->send_log(LogPacket::Severity::WARNING, "Steering encoder lost, using actuator position control");
+        steering_closed_ = false;
+      }
+      steering_.reset();
+      send_steering_angle(steering);
+      return;
+    }
+    steering_.set_target(limit_motor_angle(map_steer2motor(steering)));
+    if (!steering_closed_) {
+      logger->send_log(LogPacket::Severity::INFO, "Steering loop closed on the encoder");
+      steering_closed_ = true;
+    }
+    float current_ma = steering_.update(steer_encoder_->get_angle(), LOOP_PERIOD_S);
+#ifdef ENABLE_LSWITCH
+    current_ma = limits_.clamp_current(current_ma);
+#endif
+    actuator_->set_steer_current(current_ma / 1000.0f);
+  }
+#endif
+
+#ifdef ENABLE_SPEED_LOOP
+  void ActuationController::speed_step()
+  {
+#ifdef ENABLE_BRAKE_BLENDING
+    if (regen_active_) {
+      return;
+    }
+#endif
+    VescStatus status;
+    const bool motor_valid = motor_ && motor_->is_ready() && motor_->get_status(THROTTLE_CAN_ID, status);
+    const float motor_speed = motor_valid ? status.erpm * ERPM_TO_MS : 0.0f;
+    if (!speed_running_) {
+      // Start the ramp where the kart is, not from zero
+      speed_.reset(motor_speed);
+      speed_running_ = true;
+    }
+    speed_.set_target(throttle_cmd_);
+
+    // The wheel encoder is on the driven axle and spins with the motor, so
+    // the ground speed comes from the estimator, and only while it has the
+    // IMU. Without it the loop only ramps.
+    float ground_speed = 0.0f;
+    const bool ground_valid = motor_valid && estimator_ && estimator_->get_ground_speed(ground_speed);
+    const float command = speed_.update(ground_speed, ground_valid, motor_speed, LOOP_PERIOD_S);
+    actuator_->set_speed(command);
+
+    if (speed_.is_limiting() != traction_limiting_) {
+      traction_limiting_ = speed_.is_limiting();
+      if (traction_limiting_) {
+        logger->send_log(LogPacket::Severity::WARNING, "Traction limit active");
+      }
+    }
+  }
+#endif
+
+#ifdef BRAKE_IN_CONTROL_LOOP
+  void ActuationController::brake_step()
+  {
+    float mechanical = brake_demand_;
+#ifdef ENABLE_SETPOINT_SHAPING
+    // Only the release is shaped
+    if (mechanical >= brake_shaper_.get_value()) {
+      brake_shaper_.reset(mechanical);
+    } else {
+      mechanical = brake_shaper_.update(mechanical, LOOP_PERIOD_S);
+    }
+#endif
+#ifdef ENABLE_BRAKE_BLENDING
+    mechanical = blend(mechanical);
+#endif
+#ifdef ENABLE_BRAKE_FEEDBACK
+    const bool valid = brake_ && brake_->is_ready();
+    if (valid != brake_closed_) {
+      brake_closed_ = valid;
+      if (valid) {
+        logger->send_log(LogPacket::Severity::INFO, "Brake loop closed on the actuator reports");
+      } else {
+        logger->send_log(LogPacket::Severity::WARNING, "Brake reports lost, running the brake open loop");
+      }
+    }
+    brake_loop_.set_target(mechanical);
+    actuator_->set_brake_position(brake_loop_.update(valid ? brake_->get_position() : 0.0f, valid, LOOP_PERIOD_S));
+#else
+    actuator_->set_brake_position(brake_cmd_to_position(mechanical));
+#endif
+  }
+#endif
+
+#ifdef ENABLE_BRAKE_BLENDING
+  float ActuationController::blend(float demand)
+  {
+    // The drive VESC is only ours while the speed loop owns it; during the
+    // full reverse current brake it already brakes at its limit
+    if (!speed_armed_) {
+      regen_active_ = false;
+      return demand;
+    }
+
+    VescStatus status;
+    const bool motor_valid = motor_ && motor_->is_ready() && motor_->get_status(THROTTLE_CAN_ID, status);
+    const bool wheel_valid = motor_valid && wheel_;
+    const float speed = wheel_valid ? wheel_->get_speed() : status.erpm * ERPM_TO_MS;
+    const BrakeAllocation allocation = BrakeAllocator::allocate(demand, speed, motor_valid, status.voltage_in, motor_valid);
+
+    if (allocation.regen > 0.0f) {
+      actuator_->set_drive_brake(allocation.regen);
+      regen_active_ = true;
+    } else if (regen_active_) {
+      // Hand the VESC back to the speed loop, restarting its ramp from here
+      regen_active_ = false;
+      speed_running_ = false;
+    }
+    return allocation.mechanical;
   }
-} // namespace tritonai::gkc
\ No newline at end of file
+#endif
+} // namespace tritonai::gkc
@@ -6,17 +6,59 @@
 #include "Tools/logger.hpp"
 #include "mbed.h"
 #include "Sensor/sensor_reader.hpp"
+#include "Sensor/steer_encoder_provider.hpp"
+#include "Sensor/vesc_status_provider.hpp"
+#include "Sensor/wheel_odometry_provider.hpp"
+#include "Sensor/brake_status_provider.hpp"
+#include "Sensor/state_estimator.hpp"
+#include "Actuation/steering_controller.hpp"
+#include "Actuation/speed_controller.hpp"
+#include "Actuation/brake_controller.hpp"
+#include "Actuation/brake_allocator.hpp"
+#include "Actuation/setpoint_shaper.hpp"
+#include "Actuation/steering_limits.hpp"
+#include "Actuation/vehicle_actuator.hpp"
+#include <atomic>
 #include <cstdint>
 
+#if defined(ENABLE_BRAKE_BLENDING) && !defined(ENABLE_SPEED_LOOP)
+#error "ENABLE_BRAKE_BLENDING needs ENABLE_SPEED_LOOP to share the drive VESC"
+#endif
+#if defined(ENABLE_STEERING_CALIB) && !defined(ENABLE_LSWITCH)
+#error "ENABLE_STEERING_CALIB needs ENABLE_LSWITCH to find the stops"
+#endif
+#if defined(ENABLE_BRAKE_FEEDBACK) || defined(ENABLE_BRAKE_BLENDING)
+#define BRAKE_IN_CONTROL_LOOP // the brake is sent from the control thread
+#endif
+#if defined(ENABLE_STEER_PID) || defined(ENABLE_SPEED_LOOP) || \
+    defined(BRAKE_IN_CONTROL_LOOP)
+#define ACTUATION_CONTROL_LOOP // runs the local loops every PID_INTERVAL_MS
+#endif
+
 namespace tritonai::gkc {
 class ActuationController {
 public:
-  explicit ActuationController(ILogger *logger);
+  ActuationController(ILogger *logger, VehicleActuator *actuator);
+
+  // Feedback for the local loops. A loop without its feedback falls back to
+  // the open-loop actuator command.
+  void use_steer_encoder(SteerEncoderProvider *encoder) { steer_encoder_ = encoder; }
+  void use_motor(VescStatusProvider *motor) { motor_ = motor; }
+  void use_wheel(WheelOdometryProvider *wheel) { wheel_ = wheel; }
+  void use_brake(BrakeStatusProvider *brake) { brake_ = brake; }
+  // ground speed reference of the slip band
+  void use_estimator(StateEstimator *estimator) { estimator_ = estimator; }
 
   void set_throttle_cmd(float cmd);
   void set_steering_cmd(float cmd);
   void set_brake_cmd(float cmd);
   void full_rel_rev_current_brake();
+  // brakes every actuator at once
+  void emergency_stop();
+  // Sweeps the steering to both stops to find its center and travel. Blocks
+  // for a few seconds, returns false and keeps the configured offsets if
+  // the calibration is disabled or fails.
+  bool calibrate_steering();
 
   float clamp(float val, float max, float min) {
     if (val < min)
@@ -29,7 +71,75 @@ public:
 
   ILogger *logger;
 
+protected:
+  VehicleActuator *actuator_;
+  SteerEncoderProvider *steer_encoder_{nullptr};
+  VescStatusProvider *motor_{nullptr};
+  WheelOdometryProvider *wheel_{nullptr};
+  BrakeStatusProvider *brake_{nullptr};
+  StateEstimator *estimator_{nullptr};
+
+  // ground speed from the wheel encoder, or the motor without one
+  bool measured_speed(float &speed);
+
+  SteeringCalibration calibration_;
+  // column angle last sent to the actuator position loop
+  float last_motor_angle_{0.0f};
+  // keeps a column angle inside the soft limits and off a closed switch
+  float limit_motor_angle(float motor_angle);
+  // road wheel angle through the actuator position loop
+  void send_steering_angle(float steering);
+#ifdef ENABLE_LSWITCH
+  SteeringLimits limits_;
+  void steering_limit_hit(); // ISR context
+#endif
+  std::atomic<bool> steering_calibrating_{false}; // holds off the steering commands
+#ifdef ENABLE_STEERING_CALIB
+  // false if the encoder has no reading within STEERING_CALIB_ENCODER_WAIT_MS
+  bool wait_for_steer_encoder();
+  // drives the column into one stop, positive to the left
+  bool sweep_to_stop(float direction, float &angle, float &vesc_pos, bool &vesc_valid);
+#endif
+#ifdef ENABLE_SETPOINT_SHAPING
+  SetpointShaper steering_shaper_{SHAPE_STEER_RATE_RADS, SHAPE_STEER_ACCEL_RADS2};
+  SetpointShaper brake_shaper_{SHAPE_BRAKE_RELEASE_RATE, 0.0f};
+#endif
+
+#ifdef ENABLE_STEER_PID
+  SteeringController steering_;
+  std::atomic<float> steering_cmd_{0.0f}; // road wheel angle, rad
+  std::atomic<bool> steering_armed_{false}; // set by the first command
+  bool steering_closed_{false};
+  void steering_step();
+#endif
+#ifdef ENABLE_SPEED_LOOP
+  SpeedController speed_;
+  std::atomic<float> throttle_cmd_{0.0f}; // m/s
+  std::atomic<bool> speed_armed_{false}; // cleared by the current brake
+  bool speed_running_{false};
+  bool traction_limiting_{false};
+  void speed_step();
+#endif
+#ifdef BRAKE_IN_CONTROL_LOOP
+  std::atomic<float> brake_demand_{0.0f};
+  std::atomic<bool> brake_armed_{false}; // set by the first command
+  void brake_step();
+#endif
+#ifdef ENABLE_BRAKE_FEEDBACK
+  BrakeController brake_loop_;
+  bool brake_closed_{false};
+#endif
+#ifdef ENABLE_BRAKE_BLENDING
+  bool regen_active_{false}; // the drive VESC is braking, not following speed
+  // sends the regen share, returns the mechanical share
+  float blend(float demand);
+#endif
+#ifdef ACTUATION_CONTROL_LOOP
+  Thread control_thread_{osPriorityAboveNormal, OS_STACK_SIZE, nullptr,
+                         "actuation_thread"};
+  void control_thread_impl();
+#endif
 };
 } // namespace gkc
 
-#endif // ACTUATION_CONTROLLER_HPP_
\ No newline at end of file
+#endif // ACTUATION_CONTROLLER_HPP_
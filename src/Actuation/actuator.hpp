@@ -0,0 +1,43 @@
+/**
+ * @file actuator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The hardware behind the actuation loops. An IActuator takes the final
+ * drive, steering and brake commands; the loops above it are the same for
+ * the VESCs of the kart, the servo and ESC of the RC car and the simulation.
+ *
+ */
+#ifndef ACTUATOR_HPP_
+#define ACTUATOR_HPP_
+
+namespace tritonai {
+namespace gkc {
+class IActuator {
+public:
+  IActuator() {}
+  // drive speed in m/s, negative in reverse
+  virtual void set_speed(float speed_ms) = 0;
+  // drive brake, fraction of the braking the drive can do
+  virtual void set_drive_brake(float brake_rel) = 0;
+  // steering actuator position in rad, the calibrated center included
+  virtual void set_steer_angle(float angle) = 0;
+  // steering motor current in A, positive to the left. Only called if
+  // has_steer_current() is true, which backends also state as their
+  // static constexpr bool STEER_CURRENT.
+  virtual void set_steer_current(float current) = 0;
+  virtual bool has_steer_current() const = 0;
+  // brake actuator position, MIN_BRAKE_VAL to MAX_BRAKE_VAL
+  virtual void set_brake_position(float position) = 0;
+  // removes the steering torque right away. Safe in ISR context.
+  virtual void stop_steering() = 0;
+  // brakes everything at once
+  virtual void stop_all() = 0;
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // ACTUATOR_HPP_
@@ -0,0 +1,55 @@
+/**
+ * @file brake_allocator.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "brake_allocator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+constexpr float REGEN_EQUIVALENT = REGEN_BRAKE_EQUIVALENT;
+
+// 0 at or below from, 1 at or above to
+float ramp_up(float x, float from, float to) {
+  return std::min(std::max((x - from) / (to - from), 0.0f), 1.0f);
+}
+} // namespace
+
+float BrakeAllocator::regen_capacity(float speed, float battery_v) {
+  const float by_speed =
+      ramp_up(std::fabs(speed), REGEN_MIN_SPEED_MS, REGEN_FULL_SPEED_MS);
+  const float by_battery =
+      1.0f - ramp_up(battery_v, BATTERY_REGEN_TAPER_V, BATTERY_REGEN_CUTOFF_V);
+  return by_speed * by_battery;
+}
+
+BrakeAllocation BrakeAllocator::allocate(float demand, float speed,
+                                         bool speed_valid, float battery_v,
+                                         bool battery_valid) {
+  BrakeAllocation out;
+  demand = std::min(std::max(demand, 0.0f), 1.0f);
+  const float capacity = speed_valid && battery_valid
+                             ? regen_capacity(speed, battery_v)
+                             : 0.0f;
+  if (demand >= 1.0f) {
+    out.mechanical = 1.0f;
+    out.regen = capacity;
+    return out;
+  }
+
+  // Regen first, the actuator covers the rest
+  const float regen_share = std::min(demand, REGEN_EQUIVALENT * capacity);
+  out.regen = regen_share / REGEN_EQUIVALENT;
+  out.mechanical = demand - regen_share;
+  return out;
+}
+} // namespace gkc
+} // namespace tritonai
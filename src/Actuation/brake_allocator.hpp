@@ -0,0 +1,41 @@
+/**
+ * @file brake_allocator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Splits a brake demand between regenerative braking on the drive VESC and
+ * the mechanical brake. Demand is in mechanical brake commands, so the split
+ * keeps the total deceleration. Regen is used first and fades out at low
+ * speed, where the motor cannot produce braking current, and near a full
+ * battery, which cannot absorb it. A full demand is an emergency stop: the
+ * mechanical brake then stays at full and regen comes on top.
+ *
+ */
+#ifndef BRAKE_ALLOCATOR_HPP_
+#define BRAKE_ALLOCATOR_HPP_
+
+#include "config.hpp"
+
+namespace tritonai {
+namespace gkc {
+struct BrakeAllocation {
+  float mechanical{0.0f}; // brake command, 0 to 1
+  float regen{0.0f};      // relative VESC brake current, 0 to 1
+};
+
+class BrakeAllocator {
+public:
+  // speed in m/s, battery in V; an invalid input disables regen
+  static BrakeAllocation allocate(float demand, float speed, bool speed_valid,
+                                  float battery_v, bool battery_valid);
+
+  // fraction of full regen available, 0 to 1
+  static float regen_capacity(float speed, float battery_v);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // BRAKE_ALLOCATOR_HPP_
@@ -0,0 +1,38 @@
+/**
+ * @file brake_controller.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "brake_controller.hpp"
+#include "Actuation/brake_map.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+void BrakeController::set_target(float cmd) {
+  target_ = brake_cmd_to_position(std::min(std::max(cmd, 0.0f), 1.0f));
+}
+
+float BrakeController::update(float measured, bool measured_valid, float dt) {
+  const float target = target_;
+  if (!measured_valid) {
+    trim_ = 0.0f;
+    return target;
+  }
+  const float error = target - measured;
+  if (std::fabs(error) > BRAKE_TOLERANCE) {
+    const float trim = trim_ + static_cast<float>(BRAKE_I) * error * dt;
+    trim_ = std::min(std::max(trim, static_cast<float>(-BRAKE_TRIM_MAX)),
+                     static_cast<float>(BRAKE_TRIM_MAX));
+  }
+  return std::min(std::max(target + trim_, static_cast<float>(MIN_BRAKE_VAL)),
+                  static_cast<float>(MAX_BRAKE_VAL));
+}
+} // namespace gkc
+} // namespace tritonai
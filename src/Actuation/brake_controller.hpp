@@ -0,0 +1,42 @@
+/**
+ * @file brake_controller.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Brake position loop on top of the actuator's own servo. Commands are
+ * mapped to positions through the pressure calibration, and an integral
+ * trim on the reported position removes the offset the actuator settles
+ * at under load.
+ *
+ */
+#ifndef BRAKE_CONTROLLER_HPP_
+#define BRAKE_CONTROLLER_HPP_
+
+#include "config.hpp"
+#include <atomic>
+
+namespace tritonai {
+namespace gkc {
+class BrakeController {
+public:
+  // brake command, 0 to 1 of the calibrated pressure range. Safe to call
+  // from any thread.
+  void set_target(float cmd);
+  float get_target_position() const { return target_; }
+
+  // one loop iteration, returns the position to command. measured_valid is
+  // false without actuator reports, which runs the brake open loop.
+  float update(float measured, bool measured_valid, float dt);
+  void reset() { trim_ = 0.0f; }
+
+protected:
+  std::atomic<float> target_{MIN_BRAKE_VAL}; // actuator units
+  float trim_{0.0f};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // BRAKE_CONTROLLER_HPP_
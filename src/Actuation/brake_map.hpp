@@ -0,0 +1,91 @@
+/**
+ * @file brake_map.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Brake actuator position to line pressure and back, from the
+ * BRAKE_PRESSURE_MAPPING calibration in config.hpp. Commands are given as a
+ * fraction of the highest calibrated pressure, so the same command brakes
+ * the same on any actuator once its table is measured.
+ *
+ */
+#ifndef BRAKE_MAP_HPP_
+#define BRAKE_MAP_HPP_
+
+#include "config.hpp"
+#include <cstddef>
+
+namespace tritonai {
+namespace gkc {
+namespace brake_map {
+// One row of BRAKE_PRESSURE_MAPPING
+struct Point {
+  float position; // actuator units
+  float pressure; // bar
+};
+
+constexpr Point POINTS[] = BRAKE_PRESSURE_MAPPING;
+constexpr size_t NUM_POINTS = sizeof(POINTS) / sizeof(POINTS[0]);
+static_assert(NUM_POINTS >= 2, "BRAKE_PRESSURE_MAPPING needs at least two rows");
+
+constexpr bool strictly_increasing() {
+  for (size_t i = 1; i < NUM_POINTS; ++i) {
+    if (!(POINTS[i].position > POINTS[i - 1].position) ||
+        !(POINTS[i].pressure > POINTS[i - 1].pressure)) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(strictly_increasing(),
+              "BRAKE_PRESSURE_MAPPING rows must increase in both columns");
+static_assert(POINTS[0].position >= MIN_BRAKE_VAL &&
+                  POINTS[NUM_POINTS - 1].position <= MAX_BRAKE_VAL,
+              "BRAKE_PRESSURE_MAPPING leaves the actuator travel");
+
+constexpr float MAX_PRESSURE = POINTS[NUM_POINTS - 1].pressure;
+
+// Piecewise linear through the table, x and y picked by member pointer,
+// held at the ends
+inline float interpolate(float x, float Point::*in, float Point::*out) {
+  if (x <= POINTS[0].*in) {
+    return POINTS[0].*out;
+  }
+  if (x >= POINTS[NUM_POINTS - 1].*in) {
+    return POINTS[NUM_POINTS - 1].*out;
+  }
+  size_t lo = 0;
+  size_t hi = NUM_POINTS - 1;
+  while (hi - lo > 1) {
+    const size_t mid = (lo + hi) / 2;
+    if (POINTS[mid].*in <= x) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const Point &a = POINTS[lo];
+  const Point &b = POINTS[hi];
+  return a.*out + (b.*out - a.*out) * (x - a.*in) / (b.*in - a.*in);
+}
+} // namespace brake_map
+
+// bar reached at an actuator position
+inline float brake_position_to_pressure(float position) {
+  return brake_map::interpolate(position, &brake_map::Point::position,
+                                &brake_map::Point::pressure);
+}
+
+// actuator position for a brake command, 0 to 1 of the calibrated range
+inline float brake_cmd_to_position(float cmd) {
+  return brake_map::interpolate(cmd * brake_map::MAX_PRESSURE,
+                                &brake_map::Point::pressure,
+                                &brake_map::Point::position);
+}
+} // namespace gkc
+} // namespace tritonai
+
+#endif // BRAKE_MAP_HPP_
@@ -0,0 +1,119 @@
+#include "Actuation/can_bus.hpp"
+
+namespace tritonai::gkc {
+    CAN can1(CAN1_RX, CAN1_TX, CAN1_BAUDRATE);
+    CAN can2(CAN2_RX, CAN2_TX, CAN2_BAUDRATE);
+
+    CAN &can_port(uint8_t port) {
+        return port == 1 ? can1 : can2;
+    }
+
+    int can_port_baudrate(uint8_t port) {
+        return port == 1 ? CAN1_BAUDRATE : CAN2_BAUDRATE;
+    }
+
+    namespace {
+        CanTraffic traffic[2];
+
+        // mbed keeps the HAL handle in a protected member of CAN
+        struct CanAccess : CAN {
+            static FDCAN_HandleTypeDef &handle(CAN &can) {
+                return (can.*(&CanAccess::_can)).CanHandle;
+            }
+        };
+
+        struct CanFilter {
+            uint32_t id;
+            uint32_t mask;
+        };
+        struct PortFilters {
+            CanFilter filters[CAN_MAX_FILTERS];
+            size_t count{0};
+            Mutex lock;
+        };
+        PortFilters port_filters[2];
+
+        PortFilters &filters_of(uint8_t port) {
+            return port_filters[port == 1 ? 0 : 1];
+        }
+
+        bool program_filter(FDCAN_HandleTypeDef &handle, uint32_t index,
+                            const CanFilter &filter) {
+            FDCAN_FilterTypeDef config = {};
+            config.IdType = FDCAN_EXTENDED_ID;
+            config.FilterIndex = index;
+            config.FilterType = FDCAN_FILTER_MASK;
+            config.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+            config.FilterID1 = filter.id;
+            config.FilterID2 = filter.mask;
+            return HAL_FDCAN_ConfigFilter(&handle, &config) == HAL_OK;
+        }
+
+        // mbed's init leaves standard element 0 matching every ID and the
+        // global filter accepting what matches nothing
+        void reject_unfiltered(FDCAN_HandleTypeDef &handle) {
+            FDCAN_FilterTypeDef config = {};
+            config.IdType = FDCAN_STANDARD_ID;
+            config.FilterIndex = 0;
+            config.FilterType = FDCAN_FILTER_MASK;
+            config.FilterConfig = FDCAN_FILTER_DISABLE;
+            HAL_FDCAN_ConfigFilter(&handle, &config);
+            // the global filter can only change in init mode
+            HAL_FDCAN_Stop(&handle);
+            HAL_FDCAN_ConfigGlobalFilter(&handle, FDCAN_REJECT, FDCAN_REJECT,
+                                         FDCAN_REJECT_REMOTE, FDCAN_REJECT_REMOTE);
+            HAL_FDCAN_Start(&handle);
+        }
+
+        // Bits on the wire: frame overhead, payload, interframe space, and
+        // a typical tenth for stuffing
+        uint32_t frame_bits(const CANMessage &msg) {
+            const uint32_t bits = (msg.format == CANExtended ? 67 : 47) + 8 * msg.len;
+            return bits + bits / 10;
+        }
+    }
+
+    bool can_add_filter(uint8_t port, uint32_t id, uint32_t mask) {
+        PortFilters &f = filters_of(port);
+        FDCAN_HandleTypeDef &handle = CanAccess::handle(can_port(port));
+        f.lock.lock();
+        if (f.count == CAN_MAX_FILTERS || f.count >= handle.Init.ExtFiltersNbr) {
+            f.lock.unlock();
+            return false;
+        }
+        const CanFilter filter{id, mask};
+        if (!program_filter(handle, f.count, filter)) {
+            f.lock.unlock();
+            return false;
+        }
+        f.filters[f.count] = filter;
+        if (f.count++ == 0) {
+            reject_unfiltered(handle);
+        }
+        f.lock.unlock();
+        return true;
+    }
+
+    void can_restart(uint8_t port) {
+        // On bus-off the FDCAN sets INIT and stops. Clearing it starts the
+        // recovery sequence of 128 x 11 recessive bits, nothing else changes.
+        FDCAN_HandleTypeDef &handle = CanAccess::handle(can_port(port));
+        handle.Instance->CCCR &= ~FDCAN_CCCR_INIT;
+    }
+
+    CanTraffic &can_traffic(uint8_t port) {
+        return traffic[port == 1 ? 0 : 1];
+    }
+
+    void can_count_tx(uint8_t port, const CANMessage &msg) {
+        CanTraffic &t = can_traffic(port);
+        ++t.tx_frames;
+        t.tx_bits += frame_bits(msg);
+    }
+
+    void can_count_rx(uint8_t port, const CANMessage &msg) {
+        CanTraffic &t = can_traffic(port);
+        ++t.rx_frames;
+        t.rx_bits += frame_bits(msg);
+    }
+} // namespace tritonai::gkc
@@ -0,0 +1,59 @@
+#ifndef CAN_BUS_HPP_
+#define CAN_BUS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "mbed.h"
+#include "config.hpp"
+
+namespace tritonai::gkc {
+    // The two CAN peripherals, shared by the actuation (TX) and sensor (RX)
+    // paths. Ports are numbered like the *_CAN_PORT settings in config.hpp.
+    extern CAN can1;
+    extern CAN can2;
+
+    CAN &can_port(uint8_t port);
+    int can_port_baudrate(uint8_t port);
+
+    // Hardware acceptance filters for extended IDs, one filter element each.
+    // mbed's CAN::filter always writes element 0 and leaves the controller
+    // accepting every frame, so these program the FDCAN through HAL. Once a
+    // port has a filter it rejects all frames that match none. Returns false
+    // if the filter elements of the port are used up.
+    bool can_add_filter(uint8_t port, uint32_t id, uint32_t mask);
+
+    // Leaves bus-off. Unlike CAN::reset and CAN::frequency, which init the
+    // controller again with accept-all filters and no interrupts enabled,
+    // this keeps the filters, the interrupt enables and the bit timing.
+    void can_restart(uint8_t port);
+
+    // Running traffic totals of a port, fed by the TX engine and the receive
+    // threads as frames go through
+    struct CanTraffic {
+        std::atomic<uint32_t> tx_frames{0};
+        std::atomic<uint32_t> tx_bits{0};
+        std::atomic<uint32_t> rx_frames{0};
+        std::atomic<uint32_t> rx_bits{0};
+    };
+    CanTraffic &can_traffic(uint8_t port);
+    void can_count_tx(uint8_t port, const CANMessage &msg);
+    void can_count_rx(uint8_t port, const CANMessage &msg);
+
+    // Health of a port over the last monitoring interval
+    struct CanBusHealth {
+        float tx_fps{0.0f};
+        float rx_fps{0.0f};
+        float load_pct{0.0f}; // of the bit rate, stuffing estimated
+        uint8_t tx_errors{0}; // transmit error counter
+        uint8_t rx_errors{0}; // receive error counter
+        uint32_t error_passive{0}; // events since boot
+        uint32_t bus_off{0}; // events since boot
+        uint32_t last_recovery_us{0}; // bus-off to the next frame out
+        uint32_t tx_dropped{0}; // TX engine totals
+        uint32_t tx_retries{0};
+        uint32_t tx_suppressed{0};
+    };
+} // namespace tritonai::gkc
+
+#endif // CAN_BUS_HPP_
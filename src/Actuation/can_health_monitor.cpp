@@ -0,0 +1,155 @@
+/**
+ * @file can_health_monitor.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "can_health_monitor.hpp"
+#include "Actuation/can_tx_engine.hpp"
+#include "ThisThread.h"
+#include <sstream>
+
+namespace tritonai {
+namespace gkc {
+CanHealthMonitor::CanHealthMonitor(ILogger *logger) : logger_(logger) {
+  monitor_thread_.start(
+      callback(this, &CanHealthMonitor::monitor_thread_impl));
+  // On the H7 FDCAN driver BeIrq is the bus-off interrupt
+  buses_[0].can.attach([this]() { bus_off_irq(0); }, CAN::BeIrq);
+  buses_[1].can.attach([this]() { bus_off_irq(1); }, CAN::BeIrq);
+  buses_[0].can.attach([this]() { error_passive_irq(0); }, CAN::EpIrq);
+  buses_[1].can.attach([this]() { error_passive_irq(1); }, CAN::EpIrq);
+}
+
+CanBusHealth CanHealthMonitor::get_health(uint8_t port) {
+  lock_.lock();
+  const CanBusHealth health = bus(port).health;
+  lock_.unlock();
+  return health;
+}
+
+std::string CanHealthMonitor::dump(uint8_t port) {
+  const CanBusHealth h = get_health(port);
+  std::stringstream ss;
+  ss << "[CAN " << static_cast<int>(port)
+     << "]: tx (fps): " << static_cast<int>(h.tx_fps)
+     << ", rx (fps): " << static_cast<int>(h.rx_fps)
+     << ", load (%): " << static_cast<int>(h.load_pct)
+     << ", tec: " << static_cast<int>(h.tx_errors)
+     << ", rec: " << static_cast<int>(h.rx_errors)
+     << ", error passive: " << h.error_passive
+     << ", bus-off: " << h.bus_off
+     << ", last recovery (us): " << h.last_recovery_us
+     << ", tx dropped: " << h.tx_dropped
+     << ", tx retries: " << h.tx_retries
+     << ", tx suppressed: " << h.tx_suppressed;
+  return ss.str();
+}
+
+void CanHealthMonitor::bus_off_irq(size_t index) {
+  // ISR context: the recovery waits for the bus, leave it to the thread
+  ++buses_[index].bus_off;
+  monitor_thread_.flags_set(bus_off_flag(index));
+}
+
+void CanHealthMonitor::error_passive_irq(size_t index) {
+  ++buses_[index].error_passive;
+}
+
+void CanHealthMonitor::monitor_thread_impl() {
+  const auto interval = std::chrono::milliseconds(CAN_HEALTH_INTERVAL_MS);
+  auto next_sample = Kernel::Clock::now() + interval;
+  last_sample_us_ = now_us();
+  while (true) {
+    const uint32_t flags = ThisThread::flags_wait_any_until(
+        bus_off_flag(0) | bus_off_flag(1), next_sample);
+    if (!(flags & osFlagsError)) {
+      for (size_t i = 0; i < NUM_PORTS; ++i) {
+        if (flags & bus_off_flag(i)) {
+          recover(buses_[i]);
+        }
+      }
+    }
+
+    if (Kernel::Clock::now() >= next_sample) {
+      const uint64_t now = now_us();
+      const float seconds = (now - last_sample_us_) / 1e6f;
+      last_sample_us_ = now;
+      for (Bus &b : buses_) {
+        sample(b, seconds);
+      }
+      next_sample += interval;
+    }
+  }
+}
+
+void CanHealthMonitor::sample(Bus &b, float seconds) {
+  const CanTraffic &traffic = can_traffic(b.port);
+  const uint32_t tx_frames = traffic.tx_frames;
+  const uint32_t tx_bits = traffic.tx_bits;
+  const uint32_t rx_frames = traffic.rx_frames;
+  const uint32_t rx_bits = traffic.rx_bits;
+  CanTxEngine &engine = CanTxEngine::instance();
+
+  lock_.lock();
+  CanBusHealth &h = b.health;
+  if (seconds > 0.0f) {
+    h.tx_fps = (tx_frames - b.last_tx_frames) / seconds;
+    h.rx_fps = (rx_frames - b.last_rx_frames) / seconds;
+    const float bits = static_cast<float>((tx_bits - b.last_tx_bits) +
+                                          (rx_bits - b.last_rx_bits));
+    h.load_pct = 100.0f * bits / (seconds * can_port_baudrate(b.port));
+  }
+  h.tx_errors = b.can.tderror();
+  h.rx_errors = b.can.rderror();
+  h.error_passive = b.error_passive;
+  h.bus_off = b.bus_off;
+  h.tx_dropped = engine.get_dropped(b.port);
+  h.tx_retries = engine.get_retries(b.port);
+  h.tx_suppressed = engine.get_suppressed(b.port);
+  lock_.unlock();
+
+  b.last_tx_frames = tx_frames;
+  b.last_tx_bits = tx_bits;
+  b.last_rx_frames = rx_frames;
+  b.last_rx_bits = rx_bits;
+}
+
+void CanHealthMonitor::recover(Bus &b) {
+  const uint64_t start = now_us();
+  const uint32_t tx_before = can_traffic(b.port).tx_frames;
+  can_restart(b.port);
+
+  // The TX engine is still holding the frames that failed, the first one
+  // through marks the bus as back
+  const uint64_t deadline = start + CAN_HEALTH_RECOVERY_TIMEOUT_MS * 1000ull;
+  while (can_traffic(b.port).tx_frames == tx_before && now_us() < deadline) {
+    ThisThread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const bool recovered = can_traffic(b.port).tx_frames != tx_before;
+  const uint32_t elapsed = static_cast<uint32_t>(now_us() - start);
+
+  lock_.lock();
+  b.health.bus_off = b.bus_off;
+  if (recovered) {
+    b.health.last_recovery_us = elapsed;
+  }
+  lock_.unlock();
+
+  if (recovered) {
+    logger_->send_log(LogPacket::Severity::WARNING,
+                      "CAN " + std::to_string(b.port) +
+                          " bus-off, recovered in " +
+                          std::to_string(elapsed) + " us");
+  } else {
+    logger_->send_log(LogPacket::Severity::ERROR,
+                      "CAN " + std::to_string(b.port) +
+                          " bus-off, no frame out after restart");
+  }
+}
+} // namespace gkc
+} // namespace tritonai
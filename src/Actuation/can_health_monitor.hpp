@@ -0,0 +1,77 @@
+/**
+ * @file can_health_monitor.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Watches both CAN buses: frame rates and bus load from the traffic
+ * counters, the controller's error counters, error passive and bus-off
+ * events. A bus-off controller stays off the bus until it is restarted, so
+ * the monitor restarts it and times how long the bus was lost, measured up
+ * to the first frame that goes out again. Received frames are those that
+ * pass the acceptance filters, so the load is a lower bound on a bus with
+ * traffic for other nodes.
+ *
+ */
+#ifndef CAN_HEALTH_MONITOR_HPP_
+#define CAN_HEALTH_MONITOR_HPP_
+
+#include "Actuation/can_bus.hpp"
+#include "Tools/logger.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tritonai {
+namespace gkc {
+class CanHealthMonitor {
+public:
+  explicit CanHealthMonitor(ILogger *logger);
+
+  // numbers of a port over the last CAN_HEALTH_INTERVAL_MS
+  CanBusHealth get_health(uint8_t port);
+  // one line in the format of the profiler dumps
+  std::string dump(uint8_t port);
+
+protected:
+  static constexpr size_t NUM_PORTS = 2;
+
+  struct Bus {
+    Bus(CAN &can, uint8_t port) : can(can), port(port) {}
+    CAN &can;
+    uint8_t port;
+    CanBusHealth health;
+    uint32_t last_tx_frames{0};
+    uint32_t last_tx_bits{0};
+    uint32_t last_rx_frames{0};
+    uint32_t last_rx_bits{0};
+    std::atomic<uint32_t> error_passive{0};
+    std::atomic<uint32_t> bus_off{0};
+  };
+  Bus buses_[NUM_PORTS]{{can1, 1}, {can2, 2}};
+  ILogger *logger_;
+  Mutex lock_;
+  uint64_t last_sample_us_{0};
+
+  Thread monitor_thread_{osPriorityAboveNormal, OS_STACK_SIZE, nullptr,
+                         "can_health_thread"};
+
+  static uint32_t bus_off_flag(size_t index) { return 1u << index; }
+  Bus &bus(uint8_t port) { return buses_[port == 1 ? 0 : 1]; }
+
+  void bus_off_irq(size_t index);
+  void error_passive_irq(size_t index);
+  void monitor_thread_impl();
+  void sample(Bus &bus, float seconds);
+  void recover(Bus &bus);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // CAN_HEALTH_MONITOR_HPP_
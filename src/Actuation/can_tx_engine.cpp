@@ -0,0 +1,259 @@
+/**
+ * @file can_tx_engine.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "can_tx_engine.hpp"
+#include <cstring>
+
+namespace tritonai {
+namespace gkc {
+CanTxEngine &CanTxEngine::instance() {
+  // Function-local so the buses are constructed before the engine
+  static CanTxEngine engine;
+  return engine;
+}
+
+CanTxEngine::CanTxEngine() {
+  tx_thread_.start(callback(this, &CanTxEngine::tx_thread_impl));
+  buses_[0].can.attach([this]() { tx_irq(0); }, CAN::TxIrq);
+  buses_[1].can.attach([this]() { tx_irq(1); }, CAN::TxIrq);
+}
+
+bool CanTxEngine::send(uint8_t port, uint32_t id, const uint8_t *data,
+                       uint8_t len, CANFormat format, uint32_t node) {
+  return queue(port, node, id, data, len, format, Kind::COMMAND);
+}
+
+bool CanTxEngine::send_stop(uint8_t port, uint32_t id, const uint8_t *data,
+                            uint8_t len, CANFormat format, uint32_t node) {
+  return queue(port, node, id, data, len, format, Kind::STOP);
+}
+
+bool CanTxEngine::send_on_change(uint8_t port, uint32_t node, uint32_t id,
+                                 const uint8_t *data, uint8_t len,
+                                 CANFormat format) {
+  return queue(port, node, id, data, len, format, Kind::ON_CHANGE);
+}
+
+namespace {
+// sequence numbers wrap, compare them by distance
+inline bool older(uint32_t a, uint32_t b) {
+  return static_cast<int32_t>(a - b) < 0;
+}
+} // namespace
+
+bool CanTxEngine::queue(uint8_t port, uint32_t node, uint32_t id,
+                        const uint8_t *data, uint8_t len, CANFormat format,
+                        Kind kind) {
+  Bus &b = bus(port);
+  if (len > 8) {
+    len = 8;
+  }
+  const bool stop = kind == Kind::STOP;
+  const uint64_t now = now_us();
+  bool evicted = false;
+
+  core_util_critical_section_enter();
+  LastSent *last = nullptr;
+  if (kind == Kind::ON_CHANGE) {
+    // With every record taken, the frame simply goes out
+    last = find_last_sent(port, node);
+    if (last && last->used && last->id == id && last->len == len &&
+        std::memcmp(last->data, data, len) == 0 &&
+        now - last->time_us < CAN_TX_KEEPALIVE_MS * 1000ull) {
+      core_util_critical_section_exit();
+      ++b.suppressed;
+      return true;
+    }
+  }
+
+  Slot *same_command = nullptr;
+  Slot *same_stop = nullptr;
+  Slot *free_slot = nullptr;
+  Slot *oldest_command = nullptr;
+  for (Slot &s : b.slots) {
+    if (!s.pending) {
+      free_slot = free_slot ? free_slot : &s;
+    } else if (s.frame.id == id && s.frame.format == format) {
+      (s.stop ? same_stop : same_command) = &s;
+    } else if (!s.stop && (!oldest_command || older(s.seq, oldest_command->seq))) {
+      oldest_command = &s;
+    }
+  }
+  // A pending stop frame is never overwritten by a command, which queues
+  // behind it in a slot of its own. A stop takes over a pending command
+  // instead, or cancels it when it joins an earlier stop.
+  Slot *slot = same_command;
+  if (stop) {
+    slot = same_stop ? same_stop : same_command;
+    if (same_stop && same_command) {
+      same_command->pending = false;
+      ++same_command->version;
+      if (same_command->node != NO_NODE) {
+        forget_locked(port, same_command->node);
+      }
+    }
+  }
+  // a pending frame taken over by this one never goes out
+  bool replaces = slot != nullptr;
+  if (!slot) {
+    if (free_slot) {
+      slot = free_slot;
+    } else if (stop && oldest_command) {
+      slot = oldest_command;
+      evicted = true;
+      replaces = true;
+    }
+    if (slot) {
+      slot->pending = true;
+      slot->stop = false;
+      slot->seq = b.next_seq++;
+    }
+  }
+  if (slot) {
+    // so its actuator has to be sent the next command again
+    if (replaces && slot->node != NO_NODE &&
+        (slot->node != node || evicted)) {
+      forget_locked(port, slot->node);
+    }
+    CANMessage &frame = slot->frame;
+    frame.id = id;
+    frame.len = len;
+    frame.format = format;
+    frame.type = CANData;
+    std::memcpy(frame.data, data, len);
+    slot->stop = slot->stop || stop;
+    slot->node = node;
+    ++slot->version;
+
+    if (last) {
+      last->used = true;
+      last->port = port;
+      last->node = node;
+      last->id = id;
+      last->len = len;
+      std::memcpy(last->data, data, len);
+      last->time_us = now;
+    } else if (kind != Kind::ON_CHANGE && node != NO_NODE) {
+      // another frame to the actuator, the recorded one is not its last
+      forget_locked(port, node);
+    }
+  }
+  core_util_critical_section_exit();
+
+  if (!slot || evicted) {
+    ++b.dropped;
+  }
+  if (slot) {
+    tx_thread_.flags_set(flag(&b - buses_));
+  }
+  return slot != nullptr;
+}
+
+CanTxEngine::LastSent *CanTxEngine::find_last_sent(uint8_t port,
+                                                   uint32_t node) {
+  LastSent *free_entry = nullptr;
+  for (LastSent &entry : last_sent_) {
+    if (entry.used && entry.port == port && entry.node == node) {
+      return &entry;
+    }
+    if (!entry.used && !free_entry) {
+      free_entry = &entry;
+    }
+  }
+  return free_entry;
+}
+
+void CanTxEngine::forget_locked(uint8_t port, uint32_t node) {
+  for (LastSent &entry : last_sent_) {
+    if (entry.used && entry.port == port && entry.node == node) {
+      entry.used = false;
+    }
+  }
+}
+
+void CanTxEngine::forget(uint8_t port, uint32_t node) {
+  core_util_critical_section_enter();
+  forget_locked(port, node);
+  core_util_critical_section_exit();
+}
+
+void CanTxEngine::tx_irq(size_t index) {
+  // ISR context: CAN::write takes a mutex, leave the work to the thread
+  tx_thread_.flags_set(flag(index));
+}
+
+void CanTxEngine::tx_thread_impl() {
+  bool pending = false;
+  while (true) {
+    if (pending) {
+      // Mailboxes were full. The TX interrupt normally wakes us, the timeout
+      // covers a bus that stopped acknowledging.
+      ThisThread::flags_wait_any_for(flag(0) | flag(1),
+                                     std::chrono::milliseconds(
+                                         CAN_TX_RETRY_MS));
+    } else {
+      ThisThread::flags_wait_any(flag(0) | flag(1));
+    }
+    pending = false;
+    for (Bus &b : buses_) {
+      pending |= drain(b);
+    }
+  }
+}
+
+CanTxEngine::Slot *CanTxEngine::next_slot(Bus &b) {
+  Slot *next = nullptr;
+  for (Slot &s : b.slots) {
+    if (!s.pending) {
+      continue;
+    }
+    if (!next || (s.stop && !next->stop) ||
+        (s.stop == next->stop && older(s.seq, next->seq))) {
+      next = &s;
+    }
+  }
+  return next;
+}
+
+bool CanTxEngine::drain(Bus &b) {
+  CANMessage frame;
+  while (true) {
+    core_util_critical_section_enter();
+    Slot *slot = next_slot(b);
+    uint32_t version = 0;
+    if (slot) {
+      frame = slot->frame;
+      version = slot->version;
+    }
+    core_util_critical_section_exit();
+    if (!slot) {
+      return false;
+    }
+
+    if (!b.can.write(frame)) {
+      // Leave it queued and try again, the controller recovers by itself
+      ++b.retries;
+      return true;
+    }
+
+    core_util_critical_section_enter();
+    // Newer data for the ID may have arrived while we were writing, then
+    // the slot stays pending and goes out again
+    if (slot->version == version) {
+      slot->pending = false;
+    }
+    core_util_critical_section_exit();
+    ++b.sent;
+    can_count_tx(b.port, frame);
+  }
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,144 @@
+/**
+ * @file can_tx_engine.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Outgoing CAN traffic of the actuation path. Each bus has a table of
+ * preallocated slots, one per CAN ID waiting to go out, so one per actuator
+ * and command. A frame with the ID of a pending one replaces its data
+ * instead of queueing behind it: only the latest value of a command is
+ * worth sending, and no actuator's frame is pushed out by another's. The
+ * exception is a pending stop frame, which no command may overwrite; a
+ * command to its ID takes a second slot. Slots go out oldest first, stop
+ * frames ahead of all commands, as soon as a TX mailbox is free. The
+ * TX-complete interrupt only wakes the drain thread, since CAN::write takes
+ * a mutex. A full mailbox is retried rather than answered with a
+ * controller reset.
+ *
+ * Commands can also be sent on change: the last frame queued to each
+ * actuator is remembered, and a repeat goes out only once the keepalive
+ * interval has passed, which is what the actuator timeouts need. Any other
+ * frame to the actuator, or the loss of its pending frame, clears the
+ * record, so the next command always goes out. The record is kept in the
+ * same critical sections as the slots, so every call is safe in ISR
+ * context.
+ *
+ */
+#ifndef CAN_TX_ENGINE_HPP_
+#define CAN_TX_ENGINE_HPP_
+
+#include "Actuation/can_bus.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+class CanTxEngine {
+public:
+  // the engine of the process, started on first use. The first call starts
+  // a thread and must not be made in ISR context.
+  static CanTxEngine &instance();
+
+  // a frame that is not for one actuator
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+  // queues a frame for a port numbered like the *_CAN_PORT settings. A
+  // pending command with the same ID takes the new data. Returns false if
+  // every slot holds another ID, then the frame is dropped. node names the
+  // actuator the frame is for, if send_on_change also commands it.
+  bool send(uint8_t port, uint32_t id, const uint8_t *data, uint8_t len,
+            CANFormat format = CANExtended, uint32_t node = NO_NODE);
+  // like send, for frames that stop actuators, broadcasts included. They go
+  // out ahead of the commands and are never dropped to make room: with
+  // every slot taken, the oldest pending command is dropped instead.
+  bool send_stop(uint8_t port, uint32_t id, const uint8_t *data, uint8_t len,
+                 CANFormat format = CANExtended, uint32_t node = NO_NODE);
+
+  // like send, but skips a frame identical to the last one queued to the
+  // same actuator within CAN_TX_KEEPALIVE_MS. node names the actuator;
+  // switching it to another command ID always goes out.
+  bool send_on_change(uint8_t port, uint32_t node, uint32_t id,
+                      const uint8_t *data, uint8_t len,
+                      CANFormat format = CANExtended);
+  // drops what send_on_change remembers about an actuator, so that its next
+  // command goes out even if it repeats the last one
+  void forget(uint8_t port, uint32_t node);
+
+  uint32_t get_sent(uint8_t port) const { return bus(port).sent; }
+  uint32_t get_suppressed(uint8_t port) const { return bus(port).suppressed; }
+  uint32_t get_dropped(uint8_t port) const { return bus(port).dropped; }
+  uint32_t get_retries(uint8_t port) const { return bus(port).retries; }
+
+protected:
+  static constexpr size_t NUM_PORTS = 2;
+
+  struct Slot {
+    CANMessage frame;
+    bool pending{false};
+    bool stop{false};
+    uint32_t node{NO_NODE}; // actuator the frame is for
+    uint32_t seq{0};     // when it became pending, sets the send order
+    uint32_t version{0}; // bumped on every write of the frame
+  };
+
+  struct Bus {
+    Bus(CAN &can, uint8_t port) : can(can), port(port) {}
+    CAN &can;
+    uint8_t port;
+    Slot slots[CAN_TX_SLOTS];
+    uint32_t next_seq{0};
+    std::atomic<uint32_t> sent{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> retries{0};
+    std::atomic<uint32_t> suppressed{0};
+  };
+  Bus buses_[NUM_PORTS]{{can1, 1}, {can2, 2}};
+
+  // last command sent to each actuator
+  struct LastSent {
+    bool used{false};
+    uint8_t port{0};
+    uint32_t node{0};
+    uint32_t id{0};
+    uint8_t len{0};
+    uint8_t data[8]{};
+    uint64_t time_us{0};
+  };
+  // written in critical sections only, like the slots
+  LastSent last_sent_[CAN_TX_DEDUP_SLOTS];
+
+  Thread tx_thread_{osPriorityAboveNormal, OS_STACK_SIZE, nullptr,
+                    "can_tx_thread"};
+
+  CanTxEngine();
+  Bus &bus(uint8_t port) { return buses_[port == 1 ? 0 : 1]; }
+  const Bus &bus(uint8_t port) const { return buses_[port == 1 ? 0 : 1]; }
+  static uint32_t flag(size_t index) { return 1u << index; }
+
+  enum class Kind { COMMAND, STOP, ON_CHANGE };
+  bool queue(uint8_t port, uint32_t node, uint32_t id, const uint8_t *data,
+             uint8_t len, CANFormat format, Kind kind);
+  // the record of an actuator, or a free one to take. Null if neither is
+  // left. Call in a critical section.
+  LastSent *find_last_sent(uint8_t port, uint32_t node);
+  // call in a critical section
+  void forget_locked(uint8_t port, uint32_t node);
+  // the slot to send next, call in a critical section
+  static Slot *next_slot(Bus &bus);
+  void tx_irq(size_t index);
+  void tx_thread_impl();
+  // moves queued frames into free mailboxes, returns true if any are left
+  bool drain(Bus &bus);
+};
+
+} // namespace gkc
+} // namespace tritonai
+
+#endif // CAN_TX_ENGINE_HPP_
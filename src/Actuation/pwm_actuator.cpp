@@ -0,0 +1,72 @@
+/**
+ * @file pwm_actuator.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "pwm_actuator.hpp"
+#include "PeripheralPins.h"
+#include "pinmap.h"
+#include <algorithm>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+// the timer behind the PWM channel of a pin
+TIM_TypeDef *pwm_timer(PinName pin) {
+  return (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
+}
+
+// Returns pin if its timer is free for a PWM output. The encoders run whole
+// timers in input modes, and constructing a PwmOut on one of them would
+// reprogram it, so this runs in the initializer list before that happens.
+PinName free_pwm_pin(PinName pin) {
+#ifdef STEER_ENCODER_USE_CAPTURE
+  if (pwm_timer(pin) == pwm_timer(STEER_ENCODER_PIN)) {
+    error("PwmActuator: PWM pin shares a timer with the steering encoder\r\n");
+  }
+#endif
+#if defined(ENABLE_WHEEL_ENCODER) && defined(WHEEL_ENCODER_USE_TIMER)
+  if (pwm_timer(pin) == pwm_timer(WHEEL_ENCODER_A_PIN)) {
+    error("PwmActuator: PWM pin shares a timer with the wheel encoder\r\n");
+  }
+#endif
+  return pin;
+}
+} // namespace
+
+PwmActuator::PwmActuator(PinName steer_pin, PinName throttle_pin)
+    : steer_(free_pwm_pin(steer_pin)), throttle_(free_pwm_pin(throttle_pin)) {
+  steer_.period_us(PWM_PERIOD_US);
+  throttle_.period_us(PWM_PERIOD_US);
+  // Neutral, which is also what arms most ESCs
+  steer_.pulsewidth_us(PWM_CENTER_US);
+  throttle_.pulsewidth_us(PWM_CENTER_US);
+}
+
+void PwmActuator::set_speed(float speed_ms) {
+  throttle_.pulsewidth_us(pulse_us(speed_ms / PWM_THROTTLE_MAX_MS));
+}
+
+void PwmActuator::set_drive_brake(float brake_rel) {
+  if (brake_rel > 0.0f) {
+    throttle_.pulsewidth_us(PWM_CENTER_US);
+  }
+}
+
+void PwmActuator::set_steer_angle(float angle) {
+  steer_.pulsewidth_us(pulse_us(angle / PWM_STEER_MAX_RAD));
+}
+
+void PwmActuator::stop_all() { throttle_.pulsewidth_us(PWM_CENTER_US); }
+
+int PwmActuator::pulse_us(float scaled) {
+  scaled = std::min(std::max(scaled, -1.0f), 1.0f);
+  return PWM_CENTER_US + static_cast<int>(scaled * PWM_RANGE_US);
+}
+} // namespace gkc
+} // namespace tritonai
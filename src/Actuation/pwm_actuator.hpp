@@ -0,0 +1,54 @@
+/**
+ * @file pwm_actuator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The RC car: a steering servo and a drive ESC on hobby PWM, pulses of
+ * PWM_CENTER_US plus or minus PWM_RANGE_US. The ESC runs open loop and has
+ * no brake beyond neutral, and there is no brake actuator.
+ *
+ */
+#ifndef PWM_ACTUATOR_HPP_
+#define PWM_ACTUATOR_HPP_
+
+#include "Actuation/actuator.hpp"
+#include "config.hpp"
+#include "mbed.h"
+
+namespace tritonai {
+namespace gkc {
+static_assert(PWM_CENTER_US + PWM_RANGE_US < PWM_PERIOD_US &&
+                  PWM_RANGE_US < PWM_CENTER_US,
+              "PWM pulses must fit in the period");
+
+class PwmActuator final : public IActuator {
+public:
+  static constexpr bool STEER_CURRENT = false;
+
+  PwmActuator(PinName steer_pin, PinName throttle_pin);
+
+  // IActuator API
+  void set_speed(float speed_ms) override;
+  void set_drive_brake(float brake_rel) override;
+  void set_steer_angle(float angle) override;
+  void set_steer_current(float) override {}
+  bool has_steer_current() const override { return STEER_CURRENT; }
+  void set_brake_position(float) override {}
+  // A servo holds its position, the next angle is clamped off the switch
+  void stop_steering() override {}
+  void stop_all() override;
+
+protected:
+  PwmOut steer_;
+  PwmOut throttle_;
+
+  // pulse for a command, -1 to 1 of full scale
+  static int pulse_us(float scaled);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // PWM_ACTUATOR_HPP_
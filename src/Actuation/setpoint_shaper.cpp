@@ -0,0 +1,54 @@
+/**
+ * @file setpoint_shaper.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "setpoint_shaper.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+float SetpointShaper::update(float target, float dt) {
+  const float error = target - value_;
+  if (max_rate_ <= 0.0f && max_return_rate_ <= 0.0f && max_accel_ <= 0.0f) {
+    reset(target);
+    return value_;
+  }
+
+  // Fastest rate that can still be stopped at the target
+  float wanted = error / dt;
+  if (max_accel_ > 0.0f) {
+    const float stopping =
+        std::sqrt(2.0f * max_accel_ * std::fabs(error));
+    wanted = std::min(std::max(wanted, -stopping), stopping);
+  }
+  // Moving towards zero uses the return limit
+  const float max_rate = wanted * value_ < 0.0f ? max_return_rate_ : max_rate_;
+  if (max_rate > 0.0f) {
+    wanted = std::min(std::max(wanted, -max_rate), max_rate);
+  }
+
+  if (max_accel_ > 0.0f) {
+    const float step = max_accel_ * dt;
+    rate_ += std::min(std::max(wanted - rate_, -step), step);
+  } else {
+    rate_ = wanted;
+  }
+
+  const float next = value_ + rate_ * dt;
+  // Arrived, or about to pass the target
+  if ((target - next) * error <= 0.0f) {
+    reset(target);
+  } else {
+    value_ = next;
+  }
+  return value_;
+}
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,48 @@
+/**
+ * @file setpoint_shaper.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Rate and acceleration limited tracking of a setpoint. The shaped value
+ * moves towards the target no faster than max_rate, or max_return_rate on
+ * its way back towards zero, and its rate changes no faster than
+ * max_accel. It brakes in time to arrive without overshoot. For a speed
+ * setpoint the limits are acceleration, deceleration and jerk.
+ *
+ */
+#ifndef SETPOINT_SHAPER_HPP_
+#define SETPOINT_SHAPER_HPP_
+
+namespace tritonai {
+namespace gkc {
+class SetpointShaper {
+public:
+  // a limit of zero or less disables it, max_return_rate defaults to
+  // max_rate
+  SetpointShaper(float max_rate, float max_accel, float max_return_rate = 0.0f)
+      : max_rate_(max_rate), max_accel_(max_accel),
+        max_return_rate_(max_return_rate > 0.0f ? max_return_rate : max_rate) {}
+
+  // one step towards target, returns the shaped value
+  float update(float target, float dt);
+  // jumps to value at rest
+  void reset(float value) {
+    value_ = value;
+    rate_ = 0.0f;
+  }
+  float get_value() const { return value_; }
+
+protected:
+  float max_rate_;
+  float max_accel_;
+  float max_return_rate_;
+  float value_{0.0f};
+  float rate_{0.0f};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SETPOINT_SHAPER_HPP_
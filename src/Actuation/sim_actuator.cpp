@@ -0,0 +1,34 @@
+/**
+ * @file sim_actuator.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "sim_actuator.hpp"
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+void SimActuator::set_speed(float speed_ms) { speed_.set(speed_ms); }
+
+void SimActuator::set_drive_brake(float brake_rel) {
+  if (brake_rel > 0.0f) {
+    speed_.set(0.0f);
+  }
+}
+
+void SimActuator::set_steer_angle(float angle) { steer_.set(angle); }
+
+float SimActuator::Lag::get() {
+  const auto now = std::chrono::steady_clock::now();
+  const float dt = std::chrono::duration<float>(now - last).count();
+  last = now;
+  value = tau > 0.0f ? target + (value - target) * std::exp(-dt / tau) : target;
+  return value;
+}
+} // namespace gkc
+} // namespace tritonai
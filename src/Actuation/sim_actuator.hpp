@@ -0,0 +1,68 @@
+/**
+ * @file sim_actuator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * No hardware: the commands drive a first-order model of the speed and the
+ * steering angle, with time constants SIM_SPEED_TAU_S and SIM_STEER_TAU_S.
+ * It has no mbed dependency, so the control stack above it also runs in a
+ * host build.
+ *
+ */
+#ifndef SIM_ACTUATOR_HPP_
+#define SIM_ACTUATOR_HPP_
+
+#include "Actuation/actuator.hpp"
+#include "config.hpp"
+#include <chrono>
+
+namespace tritonai {
+namespace gkc {
+class SimActuator final : public IActuator {
+public:
+  static constexpr bool STEER_CURRENT = false;
+
+  SimActuator() {}
+
+  // IActuator API
+  void set_speed(float speed_ms) override;
+  void set_drive_brake(float brake_rel) override;
+  void set_steer_angle(float angle) override;
+  void set_steer_current(float) override {}
+  bool has_steer_current() const override { return STEER_CURRENT; }
+  void set_brake_position(float position) override { brake_position_ = position; }
+  void stop_steering() override {}
+  void stop_all() override { set_drive_brake(1.0f); }
+
+  // model state now
+  float get_speed() { return speed_.get(); }
+  float get_steer_angle() { return steer_.get(); }
+  float get_brake_position() const { return brake_position_; }
+
+protected:
+  // first-order lag towards the last target
+  struct Lag {
+    explicit Lag(float tau) : tau(tau) {}
+    float tau;
+    float value{0.0f};
+    float target{0.0f};
+    std::chrono::steady_clock::time_point last{std::chrono::steady_clock::now()};
+
+    float get();
+    void set(float new_target) {
+      get();
+      target = new_target;
+    }
+  };
+
+  Lag speed_{SIM_SPEED_TAU_S};
+  Lag steer_{SIM_STEER_TAU_S};
+  float brake_position_{0.0f};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SIM_ACTUATOR_HPP_
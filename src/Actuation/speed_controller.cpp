@@ -0,0 +1,69 @@
+/**
+ * @file speed_controller.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "speed_controller.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+void SpeedController::reset(float motor_speed) {
+  ramp_.reset(motor_speed);
+  integral_ = 0.0f;
+  limiting_ = false;
+}
+
+float SpeedController::update(float ground_speed, bool ground_valid,
+                              float motor_speed, float dt) {
+  // Moving away from standstill is acceleration, towards it deceleration
+  const float reference = ramp_.update(target_, dt);
+  if (!ground_valid) {
+    integral_ = 0.0f;
+    limiting_ = false;
+    return reference;
+  }
+
+  const float error = reference - ground_speed;
+  const float integral = std::min(
+      std::max(integral_ + SPEED_I * error * dt, -SPEED_TRIM_MAX_MS),
+      SPEED_TRIM_MAX_MS);
+  const float command = reference + SPEED_P * error + integral;
+
+  // Slip band around the ground speed
+  const float band =
+      std::fabs(ground_speed) * TRACTION_MAX_SLIP + TRACTION_SLIP_MARGIN_MS;
+  const float low = ground_speed - band;
+  const float high = ground_speed + band;
+  float limited = std::min(std::max(command, low), high);
+  // The VESC lags its command. A motor already past the band is aimed
+  // inside it by the overshoot, but never beyond the ground speed.
+  if (motor_speed > high) {
+    limited = std::min(limited, std::max(2.0f * high - motor_speed,
+                                         ground_speed));
+  } else if (motor_speed < low) {
+    limited = std::max(limited, std::min(2.0f * low - motor_speed,
+                                         ground_speed));
+  }
+
+  limiting_ = limited != command;
+  if (limiting_) {
+    // Hold the ramp and the integrator so they do not run away while the
+    // tyres cannot follow. A reference inside the band keeps its rate, or
+    // the jerk limit would pin it at rest while the P term is over the band.
+    if (reference < low || reference > high) {
+      ramp_.reset(std::min(std::max(reference, low), high));
+    }
+    return limited;
+  }
+  integral_ = integral;
+  return command;
+}
+} // namespace gkc
+} // namespace tritonai
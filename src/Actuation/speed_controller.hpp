@@ -0,0 +1,61 @@
+/**
+ * @file speed_controller.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Outer speed loop around the VESC RPM controller. The requested speed is
+ * ramped at the acceleration and deceleration limits, and with setpoint
+ * shaping on at the jerk limit too. This is the only limiter between the
+ * command and the motor. The ramped speed is then corrected by a PI
+ * term on the ground speed, and then kept inside a slip band around it so
+ * the driven wheels cannot spin up on launch or lock under regenerative
+ * braking. The ground speed must not come from the driven wheels, which
+ * spin with the motor; without one the band is skipped and the loop only
+ * ramps.
+ *
+ */
+#ifndef SPEED_CONTROLLER_HPP_
+#define SPEED_CONTROLLER_HPP_
+
+#include "Actuation/setpoint_shaper.hpp"
+#include "config.hpp"
+#include <atomic>
+
+namespace tritonai {
+namespace gkc {
+class SpeedController {
+public:
+  // speed to reach in m/s, negative in reverse. Safe to call from any thread.
+  void set_target(float target) { target_ = target; }
+  float get_target() const { return target_; }
+
+  // one loop iteration, returns the motor speed to command in m/s.
+  // ground_valid is false when no ground speed independent of the driven
+  // wheels is available.
+  float update(float ground_speed, bool ground_valid, float motor_speed,
+               float dt);
+  // restarts the ramp from the current motor speed
+  void reset(float motor_speed);
+
+  // true if the last update was cut back by the slip band
+  bool is_limiting() const { return limiting_; }
+
+protected:
+#ifdef ENABLE_SETPOINT_SHAPING
+  static constexpr float RAMP_JERK_MS3 = SHAPE_THROTTLE_JERK_MS3;
+#else
+  static constexpr float RAMP_JERK_MS3 = 0.0f;
+#endif
+  std::atomic<float> target_{0.0f};
+  SetpointShaper ramp_{SPEED_MAX_ACCEL_MS2, RAMP_JERK_MS3, SPEED_MAX_DECEL_MS2};
+  float integral_{0.0f};  // m/s
+  bool limiting_{false};
+
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SPEED_CONTROLLER_HPP_
@@ -0,0 +1,72 @@
+/**
+ * @file steering_controller.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "steering_controller.hpp"
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+constexpr float DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+constexpr float DEADBAND_RAD = STEER_DEADBAND_DEG * DEG_TO_RAD;
+constexpr float LOOP_HZ = 1000.0f / PID_INTERVAL_MS;
+} // namespace
+
+SteeringController::SteeringController()
+    : rate_filter_(Biquad::lowpass(LOOP_HZ, STEER_D_LOWPASS_HZ)) {}
+
+void SteeringController::reset() {
+  integral_ = 0.0f;
+  primed_ = false;
+}
+
+float SteeringController::feedforward(float target) {
+  return target * (target >= 0.0f ? STEADY_STATE_CURRENT_MULT_POS
+                                  : STEADY_STATE_CURRENT_MULT_NEG);
+}
+
+float SteeringController::update(float measured, float dt) {
+  float error = target_ - measured;
+  if (std::fabs(error) < DEADBAND_RAD) {
+    error = 0.0f;
+  }
+
+  // Derivative on the measurement, so a step in the target does not kick
+  if (!primed_) {
+    last_measured_ = measured;
+    rate_filter_.prime(0.0f);
+    primed_ = true;
+  }
+  const float rate = rate_filter_.process((measured - last_measured_) / dt);
+  last_measured_ = measured;
+
+  const float unclamped_integral = integral_ + STEER_I * error * dt;
+  const float base = feedforward(target_) + STEER_P * error - STEER_D * rate;
+  const float output = base + unclamped_integral;
+
+  // Conditional integration: keep the new integral unless it pushes an
+  // already saturated output further out
+  const bool high = output > MAX_STEER_CURRENT_MA;
+  const bool low = output < MIN_STEER_CURRENT_MA;
+  if (!(high && error > 0.0f) && !(low && error < 0.0f)) {
+    integral_ = unclamped_integral;
+  }
+
+  const float current = base + integral_;
+  if (current > MAX_STEER_CURRENT_MA) {
+    return MAX_STEER_CURRENT_MA;
+  }
+  if (current < MIN_STEER_CURRENT_MA) {
+    return MIN_STEER_CURRENT_MA;
+  }
+  return current;
+}
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,51 @@
+/**
+ * @file steering_controller.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Position loop for the steering column, closed on the PWM steering encoder
+ * and driving the steering VESC in current mode. The output is a PID term
+ * plus a feedforward that holds the column against the self-aligning torque,
+ * with a different gain per direction. The integrator stops while the
+ * output is saturated in the direction of the error, and errors inside the
+ * deadband are treated as zero.
+ *
+ */
+#ifndef STEERING_CONTROLLER_HPP_
+#define STEERING_CONTROLLER_HPP_
+
+#include "Sensor/signal_filter.hpp"
+#include "config.hpp"
+#include <atomic>
+
+namespace tritonai {
+namespace gkc {
+class SteeringController {
+public:
+  SteeringController();
+
+  // column angle to hold, radians. Safe to call from any thread.
+  void set_target(float target) { target_ = target; }
+  float get_target() const { return target_; }
+
+  // one loop iteration, returns the motor current in mA
+  float update(float measured, float dt);
+  // forgets the integrator and derivative history
+  void reset();
+
+protected:
+  std::atomic<float> target_{0.0f};
+  float integral_{0.0f}; // mA
+  float last_measured_{0.0f};
+  bool primed_{false};
+  Biquad rate_filter_;
+
+  static float feedforward(float target);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // STEERING_CONTROLLER_HPP_
@@ -0,0 +1,39 @@
+/**
+ * @file steering_limits.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "steering_limits.hpp"
+
+namespace tritonai {
+namespace gkc {
+SteeringLimits::SteeringLimits(Callback<void()> on_trip)
+    : left_(LEFT_LSWITCH, PullUp), right_(RIGHT_LSWITCH, PullUp),
+      on_trip_(on_trip) {
+  left_blocked_ = left_.read() == LSWITCH_PRESSED;
+  right_blocked_ = right_.read() == LSWITCH_PRESSED;
+
+  // Both edges, the level decides, so a bounce cannot leave a stale state
+  left_.rise([this]() { switch_irq(left_, left_blocked_); });
+  left_.fall([this]() { switch_irq(left_, left_blocked_); });
+  right_.rise([this]() { switch_irq(right_, right_blocked_); });
+  right_.fall([this]() { switch_irq(right_, right_blocked_); });
+}
+
+void SteeringLimits::switch_irq(InterruptIn &pin, std::atomic<bool> &blocked) {
+  const bool pressed = pin.read() == LSWITCH_PRESSED;
+  const bool was_blocked = blocked.exchange(pressed);
+  if (pressed && !was_blocked) {
+    ++trips_;
+    if (on_trip_) {
+      on_trip_();
+    }
+  }
+}
+} // namespace gkc
+} // namespace tritonai
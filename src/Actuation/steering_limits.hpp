@@ -0,0 +1,65 @@
+/**
+ * @file steering_limits.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * End of travel switches on the steering rack. Each switch interrupt marks
+ * its direction as blocked and calls back right away, so the steering motor
+ * can be stopped without waiting for the next control tick. Steering towards
+ * a blocked side is refused until its switch opens again.
+ *
+ */
+#ifndef STEERING_LIMITS_HPP_
+#define STEERING_LIMITS_HPP_
+
+#include "config.hpp"
+#include "mbed.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace tritonai {
+namespace gkc {
+// Result of the steering calibration. Angles are steering column radians
+// from the center, positive to the left.
+struct SteeringCalibration {
+  bool valid{false};
+  float left_limit{std::numeric_limits<float>::infinity()};
+  float right_limit{-std::numeric_limits<float>::infinity()};
+  float motor_offset{MOTOR_OFFSET}; // VESC position of the center, rad
+};
+
+class SteeringLimits {
+public:
+  // on_trip runs in ISR context when a switch closes
+  explicit SteeringLimits(Callback<void()> on_trip);
+
+  bool left_blocked() const { return left_blocked_; }
+  bool right_blocked() const { return right_blocked_; }
+  // direction is positive to the left
+  bool blocked(float direction) const {
+    return direction > 0.0f ? left_blocked_.load() : right_blocked_.load();
+  }
+  // zeroes a steering current that pushes into a closed switch
+  float clamp_current(float current) const {
+    return blocked(current) ? 0.0f : current;
+  }
+  uint32_t get_trips() const { return trips_; }
+
+protected:
+  InterruptIn left_;
+  InterruptIn right_;
+  std::atomic<bool> left_blocked_{false};
+  std::atomic<bool> right_blocked_{false};
+  std::atomic<uint32_t> trips_{0};
+  Callback<void()> on_trip_;
+
+  void switch_irq(InterruptIn &pin, std::atomic<bool> &blocked);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // STEERING_LIMITS_HPP_
@@ -0,0 +1,135 @@
+/**
+ * @file steering_map.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Road wheel angle to steering motor angle and back, from the steering map
+ * of the vehicle profile. The table is turned into line segments with their
+ * slopes at compile time, so a lookup either way is a binary search and one
+ * multiply-add, with no allocation.
+ *
+ */
+#ifndef STEERING_MAP_HPP_
+#define STEERING_MAP_HPP_
+
+#include "config.hpp"
+#include <cstddef>
+
+namespace tritonai {
+namespace gkc {
+namespace steering_map {
+constexpr const SteerPoint *POINTS = VEHICLE.steering_map;
+constexpr size_t NUM_POINTS = VEHICLE.steering_map_size;
+static_assert(NUM_POINTS >= 2, "the steering map needs at least two rows");
+
+constexpr bool strictly_increasing() {
+  for (size_t i = 1; i < NUM_POINTS; ++i) {
+    if (!(POINTS[i].steer > POINTS[i - 1].steer) ||
+        !(POINTS[i].motor > POINTS[i - 1].motor)) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(strictly_increasing(),
+              "steering map rows must increase in both columns");
+static_assert(POINTS[0].steer == 0.0f && POINTS[0].motor == 0.0f,
+              "the steering map must start at the centered position");
+
+// Segment i covers [steer, next steer) and starts at motor
+struct Segment {
+  float steer;
+  float motor;
+  float slope;     // motor per steer
+  float inv_slope; // steer per motor
+};
+
+struct Table {
+  Segment segments[NUM_POINTS - 1]{};
+};
+
+constexpr Table make_table() {
+  Table table;
+  for (size_t i = 0; i + 1 < NUM_POINTS; ++i) {
+    table.segments[i].steer = POINTS[i].steer;
+    table.segments[i].motor = POINTS[i].motor;
+    table.segments[i].slope = (POINTS[i + 1].motor - POINTS[i].motor) /
+                              (POINTS[i + 1].steer - POINTS[i].steer);
+    table.segments[i].inv_slope = (POINTS[i + 1].steer - POINTS[i].steer) /
+                                  (POINTS[i + 1].motor - POINTS[i].motor);
+  }
+  return table;
+}
+
+constexpr Table TABLE = make_table();
+constexpr float MAX_STEER = POINTS[NUM_POINTS - 1].steer;
+constexpr float MAX_MOTOR = POINTS[NUM_POINTS - 1].motor;
+} // namespace steering_map
+
+/**
+ * @brief Map a road wheel angle to a steering motor angle
+ * The table holds one side; the other is mirrored. Angles past the last row
+ * are held at the end of the table.
+ *
+ * @param steer_angle road wheel angle in radians
+ * @return steering motor angle in radians, without MOTOR_OFFSET
+ */
+inline float map_steer2motor(float steer_angle) {
+  using namespace steering_map;
+  const float sign = steer_angle < 0.0f ? -1.0f : 1.0f;
+  const float x = sign * steer_angle;
+  if (x >= MAX_STEER) {
+    return sign * MAX_MOTOR;
+  }
+
+  // last segment starting at or below x
+  size_t lo = 0;
+  size_t hi = NUM_POINTS - 1;
+  while (hi - lo > 1) {
+    const size_t mid = (lo + hi) / 2;
+    if (TABLE.segments[mid].steer <= x) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const Segment &seg = TABLE.segments[lo];
+  return sign * (seg.motor + seg.slope * (x - seg.steer));
+}
+
+/**
+ * @brief Map a steering motor angle to a road wheel angle, the inverse of
+ * map_steer2motor
+ *
+ * @param motor_angle steering motor angle in radians, without MOTOR_OFFSET
+ * @return road wheel angle in radians
+ */
+inline float map_motor2steer(float motor_angle) {
+  using namespace steering_map;
+  const float sign = motor_angle < 0.0f ? -1.0f : 1.0f;
+  const float x = sign * motor_angle;
+  if (x >= MAX_MOTOR) {
+    return sign * MAX_STEER;
+  }
+
+  // last segment starting at or below x
+  size_t lo = 0;
+  size_t hi = NUM_POINTS - 1;
+  while (hi - lo > 1) {
+    const size_t mid = (lo + hi) / 2;
+    if (TABLE.segments[mid].motor <= x) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const Segment &seg = TABLE.segments[lo];
+  return sign * (seg.steer + seg.inv_slope * (x - seg.motor));
+}
+} // namespace gkc
+} // namespace tritonai
+
+#endif // STEERING_MAP_HPP_
@@ -0,0 +1,48 @@
+/**
+ * @file vehicle_actuator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The actuator backend of this build. The loops hold it by its concrete
+ * type; the backends are final, so their calls are resolved and inlined at
+ * compile time instead of going through the IActuator vtable.
+ *
+ */
+#ifndef VEHICLE_ACTUATOR_HPP_
+#define VEHICLE_ACTUATOR_HPP_
+
+#include "config.hpp"
+#include <type_traits>
+
+#if defined(ACTUATOR_SIM)
+#include "Actuation/sim_actuator.hpp"
+#elif defined(ACTUATOR_PWM)
+#include "Actuation/pwm_actuator.hpp"
+#else
+#include "Actuation/vesc_can_actuator.hpp"
+#endif
+
+namespace tritonai {
+namespace gkc {
+#if defined(ACTUATOR_SIM)
+typedef SimActuator VehicleActuator;
+#elif defined(ACTUATOR_PWM)
+typedef PwmActuator VehicleActuator;
+#else
+typedef VescCanActuator VehicleActuator;
+#endif
+
+static_assert(std::is_base_of<IActuator, VehicleActuator>::value,
+              "the actuator backend must implement IActuator");
+#ifdef ENABLE_STEERING_CALIB
+static_assert(VehicleActuator::STEER_CURRENT,
+              "ENABLE_STEERING_CALIB needs an actuator with steering current "
+              "control");
+#endif
+} // namespace gkc
+} // namespace tritonai
+
+#endif // VEHICLE_ACTUATOR_HPP_
@@ -0,0 +1,48 @@
+/**
+ * @file vesc_can_actuator.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "vesc_can_actuator.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+namespace tritonai {
+namespace gkc {
+VescCanActuator::VescCanActuator() { CanTxEngine::instance(); }
+
+void VescCanActuator::set_speed(float speed_ms) { comm_can_set_speed(speed_ms); }
+
+void VescCanActuator::set_drive_brake(float brake_rel) {
+  comm_can_set_drive_brake_rel(brake_rel);
+}
+
+void VescCanActuator::set_steer_angle(float angle) {
+  comm_can_set_motor_angle(angle);
+}
+
+void VescCanActuator::set_steer_current(float current) {
+  comm_can_set_current(STEER_CAN_ID, current);
+}
+
+void VescCanActuator::set_brake_position(float position) {
+  comm_can_set_brake_position(position);
+}
+
+void VescCanActuator::stop_steering() {
+  // ISR context. A stop frame goes out ahead of the commands, and naming
+  // the node makes the next steering command go out even if it repeats
+  // the last one.
+  const uint8_t buffer[4] = {0, 0, 0, 0};
+  CanTxEngine::instance().send_stop(vesc_can_port(STEER_CAN_ID), STEER_CAN_ID |
+      ((uint32_t)CAN_PACKET_SET_CURRENT << 8), buffer, sizeof(buffer),
+      CANExtended, STEER_CAN_ID);
+}
+
+void VescCanActuator::stop_all() { comm_can_stop_all(); }
+} // namespace gkc
+} // namespace tritonai
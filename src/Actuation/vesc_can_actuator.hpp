@@ -0,0 +1,42 @@
+/**
+ * @file vesc_can_actuator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The kart: drive and steering VESCs and the brake actuator on CAN, through
+ * the VESC registry and the CAN TX engine.
+ *
+ */
+#ifndef VESC_CAN_ACTUATOR_HPP_
+#define VESC_CAN_ACTUATOR_HPP_
+
+#include "Actuation/actuator.hpp"
+
+namespace tritonai {
+namespace gkc {
+class VescCanActuator final : public IActuator {
+public:
+  static constexpr bool STEER_CURRENT = true;
+
+  // Also constructs the CAN TX engine. stop_steering runs in the limit
+  // switch interrupts, where the engine's thread could not be started, so
+  // the actuator has to be built before the SteeringLimits of the loops.
+  VescCanActuator();
+
+  // IActuator API
+  void set_speed(float speed_ms) override;
+  void set_drive_brake(float brake_rel) override;
+  void set_steer_angle(float angle) override;
+  void set_steer_current(float current) override;
+  bool has_steer_current() const override { return STEER_CURRENT; }
+  void set_brake_position(float position) override;
+  void stop_steering() override;
+  void stop_all() override;
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // VESC_CAN_ACTUATOR_HPP_
@@ -3,27 +3,27 @@
 
 #include <cstdint>
 #include <iostream>
-#include <map>
 #include "mbed.h"
 #include "config.hpp"
+#include "Actuation/can_bus.hpp"
+#include "Actuation/can_tx_engine.hpp"
+#include "Actuation/steering_map.hpp"
+#include "Actuation/vesc_registry.hpp"
 
 
 namespace tritonai::gkc {
 
-    CAN can1(CAN1_RX, CAN1_TX, CAN1_BAUDRATE);
-    CAN can2(CAN2_RX, CAN2_TX, CAN2_BAUDRATE);
-
-    static void can_transmit_eid(uint32_t id, const uint8_t *data, uint8_t len) {
-        CANMessage *cMsg;
-        cMsg = new CANMessage(id, data, len, CANData, CANExtended);
-
-        if (!can2.write(*cMsg)) {
-            can2.reset();
-            can2.frequency(CAN2_BAUDRATE);
-
-        }
-        delete cMsg;
+    // node is the actuator the frame is for, unchanged commands to it are
+    // only repeated at the keepalive interval
+    static void can_transmit_eid(uint8_t port, uint32_t node, uint32_t id, const uint8_t *data, uint8_t len) {
+        CanTxEngine::instance().send_on_change(port, node, id, data, len, CANExtended);
+    }
 
+    // The bus a VESC is wired to, by its controller ID. Unregistered IDs
+    // go to the drive bus.
+    static uint8_t vesc_can_port(uint8_t controller_id) {
+        const uint8_t port = VescRegistry::instance().port_of(controller_id);
+        return port ? port : THROTTLE_CAN_PORT;
     }
 
     typedef enum {
@@ -39,6 +39,13 @@ namespace tritonai::gkc {
         CAN_PACKET_MAKE_ENUM_32_BITS = 0xFFFFFFFF,
     } CAN_PACKET_ID;
 
+    // Every VESC command goes through here, so the registry knows it
+    static void vesc_transmit(uint8_t controller_id, CAN_PACKET_ID command, float value, const uint8_t *data, uint8_t len) {
+        VescRegistry::instance().record_command(controller_id, command, value);
+        can_transmit_eid(vesc_can_port(controller_id), controller_id, controller_id |
+                ((uint32_t)command << 8), data, len);
+    }
+
     void buffer_append_int16(uint8_t* buffer, int16_t number, int32_t *index) {
         buffer[(*index)++] = number >> 8;
         buffer[(*index)++] = number;
@@ -64,48 +71,42 @@ namespace tritonai::gkc {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_int32(buffer, (int32_t)(duty * 100000.0), &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_DUTY << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_DUTY, duty, buffer, send_index);
     }
 
     void comm_can_set_current(uint8_t controller_id, float current) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_int32(buffer, (int32_t)(current * 1000.0), &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT, current, buffer, send_index);
     }
 
     void comm_can_set_current_brake(uint8_t controller_id, float current) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_int32(buffer, (int32_t)(current * 1000.0), &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_BRAKE << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_BRAKE, current, buffer, send_index);
     }
 
     void comm_can_set_rpm(uint8_t controller_id, float rpm) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_int32(buffer, (int32_t)rpm, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_RPM << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_RPM, rpm, buffer, send_index);
     }
 
     void comm_can_set_pos(uint8_t controller_id, float pos) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_int32(buffer, (int32_t)(-1.0*pos * 1000000.0), &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_POS << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_POS, pos, buffer, send_index);
     }
 
     void comm_can_set_current_rel(uint8_t controller_id, float current_rel) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_float32(buffer, current_rel, 1e5, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_REL << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_REL, current_rel, buffer, send_index);
     }
 
     /**
@@ -116,8 +117,7 @@ namespace tritonai::gkc {
         uint8_t buffer[6];
         buffer_append_int32(buffer, (int32_t)(current * 1000.0), &send_index);
         buffer_append_float16(buffer, off_delay, 1e3, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT, current, buffer, send_index);
     }
 
     void comm_can_set_current_rel_off_delay(uint8_t controller_id, float current_rel, float off_delay) {
@@ -125,42 +125,65 @@ namespace tritonai::gkc {
         uint8_t buffer[6];
         buffer_append_float32(buffer, current_rel, 1e5, &send_index);
         buffer_append_float16(buffer, off_delay, 1e3, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_REL << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_REL, current_rel, buffer, send_index);
     }
 
     void comm_can_set_current_brake_rel(uint8_t controller_id, float current_rel) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_float32(buffer, current_rel, 1e5, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_BRAKE_REL << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_BRAKE_REL, current_rel, buffer, send_index);
     }
 
     void comm_can_set_handbrake(uint8_t controller_id, float current) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_float32(buffer, current, 1e3, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_HANDBRAKE << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_HANDBRAKE, current, buffer, send_index);
     }
 
     void comm_can_set_handbrake_rel(uint8_t controller_id, float current_rel) {
         int32_t send_index = 0;
         uint8_t buffer[4];
         buffer_append_float32(buffer, current_rel, 1e5, &send_index);
-        can_transmit_eid(controller_id |
-                ((uint32_t)CAN_PACKET_SET_CURRENT_HANDBRAKE_REL << 8), buffer, send_index);
+        vesc_transmit(controller_id, CAN_PACKET_SET_CURRENT_HANDBRAKE_REL, current_rel, buffer, send_index);
     }
 
     void comm_can_set_speed(float speed_ms) { // in m/s
-        float motor_poles = 5.0;
-        float gear_ratio = 59.0/22.0;
-        float wheel_circumference = 0.85; // in meters
-        float speed_to_erpm = speed_ms * motor_poles * gear_ratio / wheel_circumference * 60.0 ;
+        float speed_to_erpm = speed_ms * MOTOR_POLE_PAIRS * DRIVE_GEAR_RATIO / WHEEL_CIRCUMFERENCE_M * 60.0 ;
         // std::cout << "Speed to erpm: " << (int)(speed_to_erpm) << std::endl;
         // std::cout << "speed: " << (int)(speed_ms*60*60/1000) << endl;
-        comm_can_set_rpm(THROTTLE_CAN_ID, speed_to_erpm);
+        VescRegistry::instance().for_each(VescRole::DRIVE, [speed_to_erpm](uint8_t id) {
+            comm_can_set_rpm(id, speed_to_erpm);
+        });
+    }
+
+    // Relative brake current on every drive motor
+    void comm_can_set_drive_brake_rel(float current_rel) {
+        VescRegistry::instance().for_each(VescRole::DRIVE, [current_rel](uint8_t id) {
+            comm_can_set_current_brake_rel(id, current_rel);
+        });
+    }
+
+    /**
+     * Brakes every VESC on every bus with one frame per bus to the broadcast
+     * ID, sent ahead of any pending command. The remembered commands are dropped, so the
+     * first command after the stop goes out even if it repeats an older one.
+     */
+    void comm_can_stop_all() {
+        int32_t send_index = 0;
+        uint8_t buffer[4];
+        buffer_append_float32(buffer, VESC_ESTOP_BRAKE_REL, 1e5, &send_index);
+        VescRegistry &registry = VescRegistry::instance();
+        CanTxEngine &engine = CanTxEngine::instance();
+        registry.for_each_port([&](uint8_t port) {
+            engine.send_stop(port, VescRegistry::BROADCAST_ID |
+                    ((uint32_t)CAN_PACKET_SET_CURRENT_BRAKE_REL << 8), buffer, send_index);
+        });
+        registry.for_each([&](uint8_t id) {
+            registry.record_command(id, CAN_PACKET_SET_CURRENT_BRAKE_REL, VESC_ESTOP_BRAKE_REL);
+            engine.forget(vesc_can_port(id), id);
+        });
     }
 
     /**
@@ -223,71 +246,23 @@ namespace tritonai::gkc {
     }
 
 
-    /**
-     *
-     * @brief Map steering angle to motor angle
-     * This function maps the steering angle in radians to the corresponding motor
-     * angle in radians, based on a predefined lookup table. The lookup table is a
-     * map between motor angles and steering angles, obtained through empirical
-     * measurements of the relationship between the two angles. The function finds
-     * the closest two entries in the map that bound the input steering angle and
-     * linearly interpolates the motor angle between these two entries using the
-     * map_range() function. The resulting motor angle is then returned.
-     *
-     * This look up table is defined in config.hpp as STERING_MAPPTING
-     *
-     * @param steer_angle The steering angle in radians to map to a motor angle
-     * @return The corresponding motor angle in radians
-     */
-    float map_steer2motor(float steer_angle) {
-        // Define the lookup table as a map between motor angles and steering angles
-        std::map<float, float> mapping = STERING_MAPPING;
-
-        // Save sign
-        int sign = steer_angle >= 0 ? 1 : -1;
-
-        // Find the two entries in the map that bound the input steering angle and
-        // linearly interpolate between them
-        for (auto it = mapping.begin(); it != mapping.end(); it++) {
-            if ((std::next(it))->second >= sign * steer_angle) {
-
-            auto returned =
-                sign * map_range<float, float>(sign * steer_angle, it->second,
-                                                std::next(it)->second, it->first,
-                                                std::next(it)->first);
-
-            return returned;
-            }
-        }
-
-        // If the input steering angle is out of bounds of the look-up table, return 0
-        return 0;
-    }
-
-    void comm_can_set_angle(float steer_angle) 
-    { // in radians
-
-        float motor_angle = steer_angle*4.0+MOTOR_OFFSET;
+    // VESC position of the steering motor in radians
+    void comm_can_set_motor_angle(float motor_angle)
+    {
         float rad_to_deg = 180.0 / 3.14159265358979323846*motor_angle;
         comm_can_set_pos(STEER_CAN_ID, rad_to_deg);
     }
 
-    void comm_can_set_brake_position(float brake_position) {
-        if(brake_position<0.0) {
-            brake_position = 0.0;
-        }
-        else if(brake_position>1.0) {
-            brake_position = 1.0;
-        }
-        // Change 0.0 to 1.0 from unsigned int 0 to 2000
-        unsigned int pos = (unsigned int)(brake_position*(MAX_BRAKE_VAL - MIN_BRAKE_VAL)) + MIN_BRAKE_VAL;
-        static unsigned char buffer[8] = {0x0F, 0x4A, 0x00, 0xC0, 0, 0, 0, 0};
-        
+    // position in actuator units, MIN_BRAKE_VAL to MAX_BRAKE_VAL
+    void comm_can_set_brake_position(float position) {
+        position = clamp<float>(position, MIN_BRAKE_VAL, MAX_BRAKE_VAL);
+        unsigned int pos = (unsigned int)position;
+        uint8_t buffer[8] = {0x0F, 0x4A, 0x00, 0xC0, 0, 0, 0, 0};
+
         buffer[2] = pos & 0xFF;
         buffer[3] = 0xC0 | ((pos >> 8) & 0x1F);
 
-        can_transmit_eid(BRAKE_CAN_ID, buffer, 8);
-        
+        can_transmit_eid(BRAKE_CAN_PORT, BRAKE_CAN_ID, BRAKE_CAN_ID, buffer, 8);
     }
         
 } // namespace tritonai::gkc
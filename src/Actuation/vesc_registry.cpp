@@ -0,0 +1,109 @@
+/**
+ * @file vesc_registry.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "vesc_registry.hpp"
+#include "Tools/timebase.hpp"
+
+namespace tritonai {
+namespace gkc {
+VescRegistry &VescRegistry::instance() {
+  static VescRegistry registry;
+  return registry;
+}
+
+void VescRegistry::use_status(VescStatusProvider *status) {
+  status_for(status->get_port()) = status;
+  // Nodes added before the provider
+  for (size_t i = 0; i < num_nodes_; ++i) {
+    if (nodes_[i].port == status->get_port()) {
+      status->add_node(nodes_[i].id);
+    }
+  }
+}
+
+bool VescRegistry::add(uint8_t id, uint8_t port, VescRole role,
+                       uint32_t timeout_ms) {
+  if (num_nodes_ == MAX_NODES || find(id)) {
+    return false;
+  }
+  VescNode &node = nodes_[num_nodes_];
+  node.id = id;
+  node.port = port;
+  node.role = role;
+  node.timeout_ms = timeout_ms;
+  ++num_nodes_;
+
+  VescStatusProvider *status = status_for(port);
+  if (status) {
+    status->add_node(id);
+  }
+  return true;
+}
+
+uint8_t VescRegistry::port_of(uint8_t id) const {
+  const VescNode *node = find(id);
+  return node ? node->port : 0;
+}
+
+void VescRegistry::record_command(uint8_t id, uint8_t command, float value) {
+  VescNode *node = find(id);
+  if (!node) {
+    return;
+  }
+  const uint64_t now = now_us();
+  lock_.lock();
+  node->last_command = command;
+  node->last_value = value;
+  node->last_command_us = now;
+  lock_.unlock();
+}
+
+bool VescRegistry::get_node(uint8_t id, VescNode &node) {
+  const VescNode *found = find(id);
+  if (!found) {
+    return false;
+  }
+  lock_.lock();
+  node = *found;
+  lock_.unlock();
+  return true;
+}
+
+bool VescRegistry::get_status(uint8_t id, VescStatus &status) {
+  const VescNode *node = find(id);
+  if (!node) {
+    return false;
+  }
+  VescStatusProvider *provider = status_for(node->port);
+  if (!provider || !provider->get_status(id, status)) {
+    return false;
+  }
+  return now_us() - status.timestamp_us < node->timeout_ms * 1000ull;
+}
+
+VescNode *VescRegistry::find(uint8_t id) {
+  for (size_t i = 0; i < num_nodes_; ++i) {
+    if (nodes_[i].id == id) {
+      return &nodes_[i];
+    }
+  }
+  return nullptr;
+}
+
+const VescNode *VescRegistry::find(uint8_t id) const {
+  for (size_t i = 0; i < num_nodes_; ++i) {
+    if (nodes_[i].id == id) {
+      return &nodes_[i];
+    }
+  }
+  return nullptr;
+}
+} // namespace gkc
+} // namespace tritonai
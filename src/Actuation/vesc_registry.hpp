@@ -0,0 +1,112 @@
+/**
+ * @file vesc_registry.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The VESCs on the kart, keyed by CAN ID, with the bus each one is wired
+ * to and its role. Every command sent to a node is remembered. Its status
+ * comes from the status provider listening on its bus. Commands for the
+ * drive go to every DRIVE node, so a second rear motor is only one more
+ * entry.
+ *
+ */
+#ifndef VESC_REGISTRY_HPP_
+#define VESC_REGISTRY_HPP_
+
+#include "Sensor/vesc_status_provider.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+enum class VescRole : uint8_t { DRIVE, STEER };
+
+struct VescNode {
+  uint8_t id{0};
+  uint8_t port{0};
+  VescRole role{VescRole::DRIVE};
+  uint32_t timeout_ms{VESC_STATUS_TIMEOUT_MS}; // status older than this is stale
+  // last command, as its CAN_PACKET_ID and value
+  uint8_t last_command{0};
+  float last_value{0.0f};
+  uint64_t last_command_us{0}; // now_us() time, 0 before the first command
+};
+
+class VescRegistry {
+public:
+  // VESCs take a command sent to this ID as addressed to them
+  static constexpr uint8_t BROADCAST_ID = 255;
+
+  // the registry of the process
+  static VescRegistry &instance();
+
+  // status for the nodes on the provider's bus comes from it
+  void use_status(VescStatusProvider *status);
+  // Nodes are added at startup, before the first command. IDs are unique
+  // across the buses so that commands can name a VESC by its ID alone.
+  // Returns false if the ID is taken or the registry is full.
+  bool add(uint8_t id, uint8_t port, VescRole role,
+           uint32_t timeout_ms = VESC_STATUS_TIMEOUT_MS);
+
+  // bus of a node, or 0 if it is unknown. Safe in ISR context.
+  uint8_t port_of(uint8_t id) const;
+  // calls f(id) for every node
+  template <typename F> void for_each(F f) const {
+    for (size_t i = 0; i < num_nodes_; ++i) {
+      f(nodes_[i].id);
+    }
+  }
+  // calls f(id) for every node with the role
+  template <typename F> void for_each(VescRole role, F f) const {
+    for (size_t i = 0; i < num_nodes_; ++i) {
+      if (nodes_[i].role == role) {
+        f(nodes_[i].id);
+      }
+    }
+  }
+  // calls f(port) once for every bus with a node on it
+  template <typename F> void for_each_port(F f) const {
+    bool seen[3]{};
+    for (size_t i = 0; i < num_nodes_; ++i) {
+      const uint8_t port = nodes_[i].port;
+      if (port < 3 && !seen[port]) {
+        seen[port] = true;
+        f(port);
+      }
+    }
+  }
+
+  void record_command(uint8_t id, uint8_t command, float value);
+  // copies a node with its last command, returns false if it is unknown
+  bool get_node(uint8_t id, VescNode &node);
+  // last status of a node, returns false if there is none within its timeout
+  bool get_status(uint8_t id, VescStatus &status);
+  bool is_alive(uint8_t id) {
+    VescStatus status;
+    return get_status(id, status);
+  }
+
+protected:
+  static constexpr size_t MAX_NODES = 4;
+
+  VescNode nodes_[MAX_NODES];
+  size_t num_nodes_{0};
+  VescStatusProvider *status_[2]{}; // by bus
+  Mutex lock_; // the last commands
+
+  VescRegistry() = default;
+  VescNode *find(uint8_t id);
+  const VescNode *find(uint8_t id) const;
+  VescStatusProvider *&status_for(uint8_t port) {
+    return status_[port == 1 ? 0 : 1];
+  }
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // VESC_REGISTRY_HPP_
@@ -17,6 +17,7 @@
 #include "Kernel.h"
 #include "comm.hpp"
 #include "mbed.h"
+#include "Tools/crash_recorder.hpp"
 
 namespace tritonai {
 namespace gkc {
@@ -41,9 +42,15 @@ CommManager::CommManager(GkcPacketSubscriber *sub)
 
 void CommManager::send(const GkcPacket &packet) {
   auto to_send = factory_->Send(packet);
+  // several threads (heartbeat, sensor publisher, packet callbacks) send
+  // concurrently, keep the ownership queue in step with the mailbox
+  send_lock_.lock();
   if (send_queue_.try_put(to_send.get())) {
     send_queue_data_.push(to_send);
+  } else {
+    ++packets_dropped_;
   }
+  send_lock_.unlock();
 }
 
 size_t CommManager::send_impl(const GkcBuffer &buffer) {
@@ -61,7 +68,7 @@ size_t CommManager::send_impl(const GkcBuffer &buffer) {
 
 void CommManager::watchdog_callback() {
   std::cout << "CommManager Timeout detected" << std::endl;
-  NVIC_SystemReset();
+  CrashRecorder::reset("CommManager watchdog");
 }
 
 void CommManager::recv_callback() {
@@ -71,6 +78,8 @@ void CommManager::recv_callback() {
   do {
     auto num_byte_read = usb_serial_->read(buffer.data(), buffer.size());
     if (num_byte_read > 0) {
+      receive_time_us_.store(now_us());
+      bytes_received_ += num_byte_read;
       factory_->Receive(RawGkcBuffer{buffer.data(), buffer.size()});
     }
   } while (usb_serial_->available());
@@ -85,6 +94,8 @@ void CommManager::recv_callback() {
     if (uart_serial_->readable()) {
       auto num_byte_read = uart_serial_->read(buffer.data(), buffer.size());
       if (num_byte_read > 0) {
+        receive_time_us_.store(now_us());
+        bytes_received_ += num_byte_read;
         RawGkcBuffer buff;
         buff.data = buffer.data();
         buff.size = num_byte_read;
@@ -112,8 +123,14 @@ void CommManager::send_thread_impl() {
   while (!ThisThread::flags_get()) {
     GkcBuffer *buf_to_send;
     send_queue_.try_get_for(Kernel::wait_for_u32_forever, &buf_to_send);
-    send_impl(*buf_to_send);
+    if (send_impl(*buf_to_send) == buf_to_send->size()) {
+      ++packets_sent_;
+    } else {
+      ++packets_dropped_;
+    }
+    send_lock_.lock();
     send_queue_data_.pop();
+    send_lock_.unlock();
   }
 }
 } // namespace gkc
@@ -12,6 +12,7 @@
 #ifndef COMM_HPP_
 #define COMM_HPP_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -23,6 +24,7 @@
 
 #include "config.hpp"
 #include "Watchdog/watchable.hpp"
+#include "Tools/timebase.hpp"
 
 #include "tai_gokart_packet/gkc_packet_factory.hpp"
 #include "tai_gokart_packet/gkc_packet_utils.hpp"
@@ -36,11 +38,24 @@ class CommManager : public Watchable {
 public:
   explicit CommManager(GkcPacketSubscriber *sub);
   void send(const GkcPacket &packet);
+  // now_us() time the bytes of the last packet arrived. Inside packet
+  // callbacks, which run on the receive thread, that is the packet being
+  // dispatched.
+  uint64_t get_receive_time_us() const { return receive_time_us_.load(); }
+  // link statistics since boot
+  uint32_t get_packets_sent() const { return packets_sent_.load(); }
+  uint32_t get_packets_dropped() const { return packets_dropped_.load(); }
+  uint32_t get_bytes_received() const { return bytes_received_.load(); }
 
 protected:
   std::unique_ptr<GkcPacketFactory> factory_;
   Queue<GkcBuffer, SEND_QUEUE_SIZE> send_queue_;
   std::queue<std::shared_ptr<GkcBuffer>> send_queue_data_;
+  Mutex send_lock_;
+  TimeStamp receive_time_us_;
+  std::atomic<uint32_t> packets_sent_{0};
+  std::atomic<uint32_t> packets_dropped_{0};
+  std::atomic<uint32_t> bytes_received_{0};
   Thread send_thread{osPriorityNormal, OS_STACK_SIZE, nullptr, "send_thread"};
 #ifdef COMM_USB_SERIAL
   std::unique_ptr<USBSerial> usb_serial_;
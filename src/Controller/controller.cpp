@@ -13,6 +13,9 @@ namespace tritonai::gkc
   void Controller::agx_heartbeat()
   {
     HeartbeatGkcPacket packet;
+    uint32_t ticks = 0;
+    uint32_t can_ticks = 0;
+    uint32_t blackbox_faults = 0;
     std::string state;
     std::string old_state;
 
@@ -27,6 +30,36 @@ namespace tritonai::gkc
       packet.rolling_counter++;
       packet.state = get_state();
       _comm.send(packet); // Send the heartbeat packet
+#ifdef ENABLE_CRASH_RECORDER
+      if(++ticks * 100 >= CRASH_RECORDER_THREAD_STATS_INTERVAL_MS){
+        ticks = 0;
+        _crash_recorder.record_thread_stats();
+      }
+#endif
+#ifdef ENABLE_BLACKBOX
+      _blackbox.log_link(_comm.get_packets_sent(), _comm.get_packets_dropped(), _comm.get_bytes_received());
+      // Reports the storage faults whenever they grow
+      if(_blackbox.get_write_failures() + _blackbox.get_blocks_lost() != blackbox_faults){
+        blackbox_faults = _blackbox.get_write_failures() + _blackbox.get_blocks_lost();
+        send_log(LogPacket::Severity::WARNING,
+                 "Black box: " + std::to_string(_blackbox.get_write_failures()) + " failed writes, " +
+                 std::to_string(_blackbox.get_blocks_lost()) + " blocks lost, " +
+                 std::to_string(_blackbox.get_dropped()) + " records dropped");
+      }
+#endif
+#ifdef ENABLE_CAN_HEALTH
+      if(++can_ticks * 100 >= CAN_HEALTH_INTERVAL_MS){
+        can_ticks = 0;
+        for(uint8_t port = 1; port <= 2; ++port){
+          const CanBusHealth health = _can_health.get_health(port);
+#ifdef ENABLE_BLACKBOX
+          _blackbox.log_can(port, health);
+#endif
+          send_log(health.load_pct > CAN_HEALTH_LOAD_WARN_PCT ? LogPacket::Severity::WARNING : LogPacket::Severity::BEBUG,
+                   _can_health.dump(port));
+        }
+      }
+#endif
       this->inc_count(); // Increment the watchdog count for the controller
 
       
@@ -82,25 +115,115 @@ namespace tritonai::gkc
     _comm(this), // Passes the controller as the subscriber to the comm manager
     _watchdog(DEFAULT_WD_INTERVAL_MS, DEFAULT_WD_MAX_INACTIVITY_MS, DEFAULT_WD_WAKEUP_INTERVAL_MS), // Initializes the watchdog with default values
     _sensor_reader(), // Initializes the sensor reader
-    _actuation(this), // Passes the controller as the logger to the actuation controller
+    _sensor_publisher(&_sensor_reader, &_comm), // Streams sensor snapshots through the comm manager
+    _vesc_status(VESC_STATUS_CAN_PORT), // Listens to the VESC status broadcasts
+#ifdef ENABLE_IMU
+#ifdef IMU_REPLAY
+    _imu_device(IMU_AT_REST_SAMPLES, IMU_AT_REST_SAMPLES_LENGTH), // Replays synthetic samples instead of the IMU
+#else
+    _imu_device(IMU_SPI_MOSI, IMU_SPI_MISO, IMU_SPI_SCLK, IMU_SPI_CS), // IMU on its SPI bus
+#endif
+    _imu(&_imu_device), // Drains the IMU FIFO into the sensor packet
+#endif
+#ifdef ENABLE_BLACKBOX
+    _blackbox_device(BLACKBOX_SD_MOSI, BLACKBOX_SD_MISO, BLACKBOX_SD_SCLK, BLACKBOX_SD_CS, BLACKBOX_SD_FREQUENCY), // SD card holding the log
+    _blackbox(&_blackbox_device), // Records to the raw log region of the card
+#endif
+#ifdef ACTUATOR_PWM
+    _actuator(Steer_Pin, Throttle_Pin), // Servo and ESC of the RC car
+#endif
+    _actuation(this, &_actuator), // Passes the controller as the logger to the actuation controller
+#ifdef ENABLE_CAN_HEALTH
+    _can_health(this), // Reports bus-off recoveries through the controller
+#endif
     _rc_controller(this), // Passes the controller as the packet subscriber to the RC controller
     _rc_heartbeat(DEFAULT_RC_HEARTBEAT_INTERVAL_MS, DEFAULT_RC_HEARTBEAT_LOST_TOLERANCE_MS, "RCControllerHeartBeat") // Initializes the RC controller  heartbeat with default values
   {
     // Attaches the watchdog callback to the controller
     attach(callback(this, &Controller::watchdog_callback));
 
-    _keep_alive_thread.start(callback(this, &Controller::agx_heartbeat));
+    // Registers the sensor providers
+    // The VESCs, each listened to by the status provider on its bus
+    VescRegistry &vescs = VescRegistry::instance();
+    vescs.use_status(&_vesc_status);
+    vescs.add(THROTTLE_CAN_ID, THROTTLE_CAN_PORT, VescRole::DRIVE);
+#ifdef ENABLE_DUAL_DRIVE
+    vescs.add(DRIVE2_CAN_ID, DRIVE2_CAN_PORT, VescRole::DRIVE);
+#endif
+    vescs.add(STEER_CAN_ID, STEER_CAN_PORT, VescRole::STEER);
+    _sensor_reader.register_provider(&_vesc_status);
+#ifdef ENABLE_WHEEL_ENCODER
+    _sensor_reader.register_provider(&_wheel_odometry);
+#endif
+    _sensor_reader.register_provider(&_steer_encoder);
+#ifdef ENABLE_SENSOR_FILTERS
+    FilterSpec steering_filter;
+    steering_filter.median_window = FILTER_STEERING_MEDIAN;
+    steering_filter.lowpass_hz = FILTER_STEERING_LOWPASS_HZ;
+    _sensor_reader.add_filter(&_steer_encoder, &SensorGkcPacket::steering_angle_rad, steering_filter);
+    FilterSpec current_filter;
+    current_filter.notch_hz = FILTER_MOTOR_CURRENT_NOTCH_HZ;
+    current_filter.lowpass_hz = FILTER_MOTOR_CURRENT_LOWPASS_HZ;
+    _sensor_reader.add_filter(&_vesc_status, &SensorGkcPacket::motor_current, current_filter);
+#endif
+#ifdef ENABLE_BRAKE_FEEDBACK
+    _sensor_reader.register_provider(&_brake_status);
+#ifdef ENABLE_SENSOR_FILTERS
+    FilterSpec brake_filter;
+    brake_filter.lowpass_hz = FILTER_BRAKE_LOWPASS_HZ;
+    _sensor_reader.add_filter(&_brake_status, &SensorGkcPacket::brake_pressure, brake_filter);
+#endif
+#endif
+#ifdef ENABLE_IMU
+    _sensor_reader.register_provider(&_imu);
+#endif
+#ifdef ENABLE_STATE_ESTIMATOR
+    _state_estimator.use_motor(&_vesc_status);
+#ifdef ENABLE_WHEEL_ENCODER
+    _state_estimator.use_wheel(&_wheel_odometry);
+#endif
+    _state_estimator.use_steering(&_steer_encoder);
+#ifdef ENABLE_IMU
+    _state_estimator.use_imu(&_imu);
+#endif
+    // Registered last so it runs after the sensors that share its period
+    _sensor_reader.register_provider(&_state_estimator);
+#endif
+#ifdef ENABLE_BLACKBOX
+    _sensor_reader.register_provider(&_blackbox);
+#endif
+#ifdef ENABLE_CRASH_RECORDER
+    _sensor_reader.register_provider(&_crash_recorder);
+#endif
+
+    // Feedback for the local actuation loops
+    _actuation.use_steer_encoder(&_steer_encoder);
+    _actuation.use_motor(&_vesc_status);
+#ifdef ENABLE_WHEEL_ENCODER
+    _actuation.use_wheel(&_wheel_odometry);
+#endif
+#ifdef ENABLE_BRAKE_FEEDBACK
+    _actuation.use_brake(&_brake_status);
+#endif
+#ifdef ENABLE_STATE_ESTIMATOR
+    _actuation.use_estimator(&_state_estimator);
+#endif
 
     // Adds the all the objects to the watchlist
     _watchdog.add_to_watchlist(this); // Adds the controller to the watchlist
     _watchdog.add_to_watchlist(&_comm); // Adds the comm manager to the watchlist
     _watchdog.add_to_watchlist(&_sensor_reader); // Adds the sensor reader to the watchlist
+    _watchdog.add_to_watchlist(&_sensor_publisher); // Adds the sensor publisher to the watchlist
     _watchdog.add_to_watchlist(&_rc_controller); // Adds the RC controller to the watchlist
     if(_stop_on_rc_disconnect){
       _rc_heartbeat.attach(callback(this, &Controller::on_rc_disconnect)); // Attaches the RC disconnect callback to rc heartbeat
       _watchdog.add_to_watchlist(&_rc_heartbeat); // Adds the RC heartbeat to the watchlist
     }
 
+    // Started last: its first pass runs the lifecycle initialization, which
+    // calibrates the steering through the providers wired above
+    _keep_alive_thread.start(callback(this, &Controller::agx_heartbeat));
+
     send_log(LogPacket::Severity::INFO, "Controller initialized");
   }
 
@@ -108,7 +231,7 @@ namespace tritonai::gkc
   void Controller::watchdog_callback()
   {
     send_log(LogPacket::Severity::FATAL, "Controller watchdog trigger");
-    NVIC_SystemReset();
+    CrashRecorder::reset("Controller watchdog");
   }
 
   // ILogger API IMPLEMENTATION
@@ -137,6 +260,11 @@ namespace tritonai::gkc
     response.seq_number = packet.seq_number + 1;
     _comm.send(response);
 
+#ifdef ENABLE_CRASH_RECORDER
+    // The host is listening now, report what led to the last reset
+    _crash_recorder.dump(&_comm);
+#endif
+
   }
 
   void Controller::packet_callback(const Handshake2GkcPacket &packet)
@@ -331,8 +459,11 @@ namespace tritonai::gkc
   // TODO: (Moises) Implement on_initialize
   StateTransitionResult Controller::on_initialize(const GkcLifecycle &last_state)
   {
-    send_log(LogPacket::Severity::INFO, "Controller initializing");
+    send_log(LogPacket::Severity::INFO, std::string("Controller initializing, vehicle profile ") + VEHICLE.name);
+    // Before the watchdog is armed, the sweep blocks this thread for a few seconds
+    _actuation.calibrate_steering();
     _watchdog.arm(); // Arms the watchdog
+    _sensor_publisher.set_publishing(true); // No sensor packets are sent before initialization
     set_actuation_values(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE); // Set the actuation values to stop the car (brake at 20% pressure
     return StateTransitionResult::SUCCESS;
   }
@@ -355,6 +486,7 @@ namespace tritonai::gkc
   StateTransitionResult Controller::on_emergency_stop(const GkcLifecycle &last_state)
   {
     send_log(LogPacket::Severity::INFO, "Controller emergency stopping");
+    _actuation.emergency_stop(); // Every VESC at once, before the brake and steering commands
     set_actuation_values(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE); // Set the actuation values to stop the car (brake at 20% pressure
     return StateTransitionResult::SUCCESS;
   }
@@ -367,15 +499,37 @@ namespace tritonai::gkc
     return StateTransitionResult::SUCCESS;
   }
 
+  void Controller::on_state_change(const GkcLifecycle &from, const GkcLifecycle &to)
+  {
+#ifdef ENABLE_BLACKBOX
+    _blackbox.log_state(from, to);
+#endif
+#ifdef ENABLE_CRASH_RECORDER
+    _crash_recorder.record_state(from, to);
+#endif
+  }
+
   void Controller::set_actuation_values(float throttle, float steering, float brake)
   {
     if(get_state() != GkcLifecycle::Active){
       send_log(LogPacket::Severity::INFO, "Controller is not active, ignoring set_actuation_values");
+#ifdef ENABLE_BLACKBOX
+      _blackbox.log_setpoint(0.0, 0.0, brake);
+#endif
+#ifdef ENABLE_CRASH_RECORDER
+      _crash_recorder.record_command(0.0, 0.0, brake);
+#endif
       _actuation.full_rel_rev_current_brake();
       _actuation.set_brake_cmd(brake);
       _actuation.set_steering_cmd(0.0);
       return;
     }
+#ifdef ENABLE_BLACKBOX
+    _blackbox.log_setpoint(throttle, steering, brake);
+#endif
+#ifdef ENABLE_CRASH_RECORDER
+    _crash_recorder.record_command(throttle, steering, brake);
+#endif
     _actuation.set_steering_cmd(steering);
     _actuation.set_throttle_cmd(throttle);
     _actuation.set_brake_cmd(brake);
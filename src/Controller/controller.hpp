@@ -5,7 +5,24 @@
 #include "tai_gokart_packet/gkc_packet_subscriber.hpp"
 #include "Watchdog/watchdog.hpp"
 #include "Sensor/sensor_reader.hpp"
+#include "Sensor/sensor_publisher.hpp"
+#include "Sensor/vesc_status_provider.hpp"
+#include "Sensor/wheel_odometry_provider.hpp"
+#include "Sensor/steer_encoder_provider.hpp"
+#include "Sensor/brake_status_provider.hpp"
+#include "Sensor/imu_provider.hpp"
+#include "Sensor/icm42688.hpp"
+#include "Sensor/replay_imu.hpp"
+#include "Sensor/state_estimator.hpp"
+#include "Tools/blackbox.hpp"
+#ifdef ENABLE_BLACKBOX
+#include "SDBlockDevice.h"
+#endif
+#include "Tools/crash_recorder.hpp"
 #include "Actuation/actuation_controller.hpp"
+#include "Actuation/can_health_monitor.hpp"
+#include "Actuation/vesc_registry.hpp"
+#include "Actuation/vehicle_actuator.hpp"
 #include "RCController/RCController.hpp"
 #include "StateMachine/state_machine.hpp"
 #include <chrono>
@@ -55,12 +72,46 @@ namespace tritonai::gkc
       StateTransitionResult on_activate(const GkcLifecycle &last_state) override;
       StateTransitionResult on_emergency_stop(const GkcLifecycle &last_state) override;
       StateTransitionResult on_reinitialize(const GkcLifecycle &last_state) override;
+      void on_state_change(const GkcLifecycle &from, const GkcLifecycle &to) override;
 
     private:
+#ifdef ENABLE_CRASH_RECORDER
+      CrashRecorder _crash_recorder; // First, so it records from the start
+#endif
       CommManager _comm;
       Watchdog _watchdog;
       SensorReader _sensor_reader;
+      SensorPublisher _sensor_publisher;
+      VescStatusProvider _vesc_status;
+#ifdef ENABLE_WHEEL_ENCODER
+      WheelOdometryProvider _wheel_odometry;
+#endif
+      SteerEncoderProvider _steer_encoder;
+#ifdef ENABLE_BRAKE_FEEDBACK
+      BrakeStatusProvider _brake_status;
+#endif
+#ifdef ENABLE_IMU
+#ifdef IMU_REPLAY
+      ReplayImu _imu_device;
+#else
+      Icm42688 _imu_device;
+#endif
+      ImuProvider _imu;
+#endif
+#ifdef ENABLE_STATE_ESTIMATOR
+      StateEstimator _state_estimator;
+#endif
+#ifdef ENABLE_BLACKBOX
+      SDBlockDevice _blackbox_device;
+      BlackBox _blackbox;
+#endif
+      // Before _actuation: the CAN backend starts the TX engine that the
+      // limit switch interrupts of the actuation loops send through
+      VehicleActuator _actuator;
       ActuationController _actuation;
+#ifdef ENABLE_CAN_HEALTH
+      CanHealthMonitor _can_health;
+#endif
       RCController _rc_controller;
 
       Thread _keep_alive_thread{osPriorityNormal, OS_STACK_SIZE, nullptr, "keep_alive_thread"};
@@ -1,4 +1,5 @@
 #include "RCController/RCController.hpp"
+#include "Tools/crash_recorder.hpp"
 #include <iostream>
 #include <string>
 
@@ -92,6 +93,7 @@ namespace tritonai::gkc
             
 
             if(!_receiver.messageAvailable) continue; // Stop if no message available
+            _frame_time_us.store(now_us()); // Stamp the frame as soon as it is complete
 
             // std::cout << "Bus data: " << (int)(100*busData[0]) <<
             //     " " << (int)(100*busData[1]) <<
@@ -166,6 +168,6 @@ namespace tritonai::gkc
     void RCController::watchdog_callback()
     {
         std::cout << "RCController watchdog triggered" << std::endl;
-        NVIC_SystemReset();
+        CrashRecorder::reset("RCController watchdog");
     }
 } // namespace tritonai::gkc
\ No newline at end of file
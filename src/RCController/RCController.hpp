@@ -6,6 +6,7 @@
 #include "elrs_receiver.hpp"
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "Watchdog/watchable.hpp"
+#include "Tools/timebase.hpp"
 #include <Thread.h>
 
 namespace tritonai::gkc
@@ -31,6 +32,8 @@ class RCController : public Watchable
         _is_ready = false;
         return _packet;
     }
+    // now_us() time the last receiver frame arrived
+    uint64_t getFrameTime() const { return _frame_time_us.load(); }
 
     protected:
     void update();
@@ -43,6 +46,7 @@ class RCController : public Watchable
     elrc_receiver _receiver;
     RCControlGkcPacket _packet{};
     bool _is_ready;
+    TimeStamp _frame_time_us;
     GkcPacketSubscriber *_sub;
     float current_throttle=0.0;
 };
@@ -0,0 +1,54 @@
+/**
+ * @file brake_status_provider.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "brake_status_provider.hpp"
+#include "Actuation/brake_map.hpp"
+#include "Actuation/can_bus.hpp"
+#include "ThisThread.h"
+
+namespace tritonai {
+namespace gkc {
+BrakeStatusProvider::BrakeStatusProvider() : can_(can_port(BRAKE_CAN_PORT)) {
+  rx_thread_.start(callback(this, &BrakeStatusProvider::rx_thread_impl));
+  can_add_filter(BRAKE_CAN_PORT, BRAKE_REPORT_CAN_ID, 0x1FFFFFFF);
+  can_.attach(callback(this, &BrakeStatusProvider::rx_irq), CAN::RxIrq);
+}
+
+bool BrakeStatusProvider::is_ready() {
+  const uint64_t stamp = timestamp_us_.load();
+  return stamp != 0 && now_us() - stamp < BRAKE_STATUS_TIMEOUT_MS * 1000ull;
+}
+
+void BrakeStatusProvider::populate_reading(SensorGkcPacket &pkt) {
+  pkt.brake_pressure = brake_position_to_pressure(position_);
+}
+
+void BrakeStatusProvider::rx_irq() {
+  // ISR context: CAN::read takes a mutex, leave the work to the thread
+  rx_thread_.flags_set(RX_FLAG);
+}
+
+void BrakeStatusProvider::rx_thread_impl() {
+  CANMessage msg;
+  while (true) {
+    ThisThread::flags_wait_any(RX_FLAG);
+    while (can_.read(msg)) {
+      can_count_rx(BRAKE_CAN_PORT, msg);
+      if (msg.format != CANExtended || msg.id != BRAKE_REPORT_CAN_ID ||
+          msg.len < 4 || msg.data[0] != POSITION_REPORT) {
+        continue;
+      }
+      position_ = static_cast<float>(msg.data[2] | ((msg.data[3] & 0x1F) << 8));
+      timestamp_us_.store(now_us());
+    }
+  }
+}
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,65 @@
+/**
+ * @file brake_status_provider.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Position reports of the linear brake actuator on BRAKE_CAN_PORT. The
+ * layout is an unverified guess that reports mirror the position command: a
+ * type byte, then the shaft position as 13 bits little endian in bytes 2
+ * and 3, in the same units as MIN_BRAKE_VAL and MAX_BRAKE_VAL. Check it
+ * against a capture before enabling ENABLE_BRAKE_FEEDBACK. The pressure in
+ * the sensor packet comes from the BRAKE_PRESSURE_MAPPING calibration.
+ *
+ */
+#ifndef BRAKE_STATUS_PROVIDER_HPP_
+#define BRAKE_STATUS_PROVIDER_HPP_
+
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+// The RX interrupt of a bus has one owner
+static_assert(BRAKE_CAN_PORT != VESC_STATUS_CAN_PORT,
+              "brake reports and VESC status need separate CAN ports");
+
+class BrakeStatusProvider : public ISensorProvider {
+public:
+  BrakeStatusProvider();
+
+  // ISensorProvider API
+  bool is_ready() override;
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(BRAKE_STATUS_POLL_INTERVAL_MS);
+  }
+
+  // last reported shaft position, actuator units
+  float get_position() const { return position_; }
+  // now_us() time of the last report
+  uint64_t get_timestamp_us() const { return timestamp_us_.load(); }
+
+protected:
+  static constexpr uint32_t RX_FLAG = 0x1;
+  static constexpr uint8_t POSITION_REPORT = 0x98; // assumed, see above
+
+  CAN &can_;
+  std::atomic<float> position_{0.0f};
+  TimeStamp timestamp_us_;
+
+  Thread rx_thread_{osPriorityHigh, OS_STACK_SIZE, nullptr, "brake_rx_thread"};
+  void rx_irq();
+  void rx_thread_impl();
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // BRAKE_STATUS_PROVIDER_HPP_
@@ -0,0 +1,171 @@
+/**
+ * @file icm42688.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "icm42688.hpp"
+#include <cstring>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+// Bank 0 registers
+constexpr uint8_t REG_DEVICE_CONFIG = 0x11;
+constexpr uint8_t REG_FIFO_CONFIG = 0x16;
+constexpr uint8_t REG_FIFO_COUNTH = 0x2E;
+constexpr uint8_t REG_FIFO_DATA = 0x30;
+constexpr uint8_t REG_INTF_CONFIG0 = 0x4C;
+constexpr uint8_t REG_PWR_MGMT0 = 0x4E;
+constexpr uint8_t REG_GYRO_CONFIG0 = 0x4F;
+constexpr uint8_t REG_ACCEL_CONFIG0 = 0x50;
+constexpr uint8_t REG_FIFO_CONFIG1 = 0x5F;
+constexpr uint8_t REG_WHO_AM_I = 0x75;
+
+constexpr uint8_t WHO_AM_I_VALUE = 0x47;
+constexpr uint8_t SPI_READ = 0x80;
+constexpr uint8_t FIFO_HEADER_EMPTY = 0x80;
+
+constexpr uint32_t TRANSFER_DONE_FLAG = 1;
+constexpr auto TRANSFER_TIMEOUT = 5ms;
+
+// +-16 g and +-2000 dps full scale
+constexpr float ACCEL_SCALE = 9.80665f / 2048.0f;
+constexpr float GYRO_SCALE = 3.14159265f / 180.0f / 16.4f;
+
+inline int16_t be16(const uint8_t *p) {
+  return static_cast<int16_t>((p[0] << 8) | p[1]);
+}
+} // namespace
+
+MBED_ALIGN(32) uint8_t Icm42688::tx_buffer_[Icm42688::DMA_BUFFER_SIZE];
+MBED_ALIGN(32) uint8_t Icm42688::rx_buffer_[Icm42688::DMA_BUFFER_SIZE];
+
+Icm42688::Icm42688(PinName mosi, PinName miso, PinName sclk, PinName cs)
+    : spi_(mosi, miso, sclk), cs_(cs, 1) {
+  spi_.format(8, 3);
+  spi_.frequency(IMU_SPI_FREQUENCY);
+  spi_.set_dma_usage(DMA_USAGE_ALWAYS);
+  std::memset(tx_buffer_, 0, sizeof(tx_buffer_));
+  std::memset(rx_buffer_, 0, sizeof(rx_buffer_));
+}
+
+bool Icm42688::init() {
+  write_register(REG_DEVICE_CONFIG, 0x01); // soft reset
+  ThisThread::sleep_for(2ms);
+  if (read_register(REG_WHO_AM_I) != WHO_AM_I_VALUE) {
+    return false;
+  }
+
+  write_register(REG_INTF_CONFIG0, 0x30);  // FIFO count in bytes, big endian
+  write_register(REG_GYRO_CONFIG0, 0x06);  // 2000 dps, 1 kHz
+  write_register(REG_ACCEL_CONFIG0, 0x06); // 16 g, 1 kHz
+  write_register(REG_FIFO_CONFIG1, 0x07);  // accel, gyro, temperature
+  write_register(REG_FIFO_CONFIG, 0x40);   // stream to FIFO
+  write_register(REG_PWR_MGMT0, 0x0F);     // accel and gyro low noise
+  // the gyro needs 45 ms after power up before its data are valid
+  ThisThread::sleep_for(50ms);
+  return true;
+}
+
+size_t Icm42688::read_fifo(ImuSample *samples, size_t max_samples) {
+  if (!burst_read(REG_FIFO_COUNTH, 2)) {
+    return 0;
+  }
+  const size_t available =
+      static_cast<uint16_t>(be16(rx_buffer_ + 1)) / FIFO_PACKET_SIZE;
+  if (available == 0) {
+    return 0;
+  }
+  if (max_samples > IMU_MAX_BATCH) {
+    max_samples = IMU_MAX_BATCH;
+  }
+  const size_t n = available < max_samples ? available : max_samples;
+  if (!burst_read(REG_FIFO_DATA, n * FIFO_PACKET_SIZE)) {
+    return 0;
+  }
+  const uint64_t read_time_us = now_us();
+
+  // The newest sample in the FIFO was taken at most one period before the
+  // read; samples left behind for the next poll shift it back further.
+  // Older samples are placed with the chip's own timestamps, which are far
+  // less jittery than the poll time.
+  const uint8_t *newest = rx_buffer_ + 1 + (n - 1) * FIFO_PACKET_SIZE;
+  const uint16_t newest_tmst = static_cast<uint16_t>(be16(newest + 14));
+  const uint64_t newest_us =
+      read_time_us - (available - n) * SAMPLE_PERIOD_US;
+
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const uint8_t *packet = rx_buffer_ + 1 + i * FIFO_PACKET_SIZE;
+    if (packet[0] & FIFO_HEADER_EMPTY) {
+      break;
+    }
+    ImuSample &sample = samples[count++];
+    const uint16_t tmst = static_cast<uint16_t>(be16(packet + 14));
+    sample.timestamp_us =
+        newest_us - static_cast<uint16_t>(newest_tmst - tmst);
+    for (int axis = 0; axis < 3; ++axis) {
+      sample.accel[axis] = be16(packet + 1 + 2 * axis) * ACCEL_SCALE;
+      sample.gyro[axis] = be16(packet + 7 + 2 * axis) * GYRO_SCALE;
+    }
+  }
+  return count;
+}
+
+void Icm42688::write_register(uint8_t reg, uint8_t value) {
+  cs_ = 0;
+  spi_.write(reg);
+  spi_.write(value);
+  cs_ = 1;
+}
+
+uint8_t Icm42688::read_register(uint8_t reg) {
+  cs_ = 0;
+  spi_.write(reg | SPI_READ);
+  const uint8_t value = spi_.write(0x00);
+  cs_ = 1;
+  return value;
+}
+
+bool Icm42688::burst_read(uint8_t reg, size_t len) {
+  const int total = static_cast<int>(len + 1);
+  tx_buffer_[0] = reg | SPI_READ;
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t *>(tx_buffer_), total);
+#endif
+
+  transfer_done_.clear(TRANSFER_DONE_FLAG);
+  cs_ = 0;
+  if (spi_.transfer(tx_buffer_, total, rx_buffer_, total,
+                    event_callback_t(this, &Icm42688::on_transfer),
+                    SPI_EVENT_COMPLETE) != 0) {
+    cs_ = 1;
+    return false;
+  }
+  const uint32_t flags =
+      transfer_done_.wait_any_for(TRANSFER_DONE_FLAG, TRANSFER_TIMEOUT);
+  if (flags & osFlagsError) {
+    spi_.abort_transfer();
+    cs_ = 1;
+    return false;
+  }
+  cs_ = 1;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t *>(rx_buffer_),
+                               DMA_BUFFER_SIZE);
+#endif
+  return true;
+}
+
+void Icm42688::on_transfer(int event) {
+  transfer_done_.set(TRANSFER_DONE_FLAG);
+}
+
+} // namespace gkc
+} // namespace tritonai
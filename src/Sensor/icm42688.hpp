@@ -0,0 +1,59 @@
+/**
+ * @file icm42688.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * ICM-42688-P driver. The chip samples accel and gyro at 1 kHz into its
+ * FIFO; each poll reads the FIFO count and then the whole backlog in one
+ * SPI burst, which runs on DMA so the poll thread sleeps meanwhile instead
+ * of spinning on the bus.
+ *
+ */
+#ifndef ICM42688_HPP_
+#define ICM42688_HPP_
+
+#include "Sensor/imu_provider.hpp"
+#include "mbed.h"
+
+namespace tritonai {
+namespace gkc {
+
+class Icm42688 : public IImuDevice {
+public:
+  Icm42688(PinName mosi, PinName miso, PinName sclk, PinName cs);
+
+  // IImuDevice API
+  bool init() override;
+  size_t read_fifo(ImuSample *samples, size_t max_samples) override;
+
+protected:
+  // FIFO packet 3: header, accel xyz, gyro xyz, temperature, timestamp
+  static constexpr size_t FIFO_PACKET_SIZE = 16;
+  static constexpr uint32_t SAMPLE_PERIOD_US = 1000;
+  // one address byte plus a full batch, padded to whole cache lines so
+  // invalidating the buffer never touches neighbouring data
+  static constexpr size_t DMA_BUFFER_SIZE =
+      ((1 + IMU_MAX_BATCH * FIFO_PACKET_SIZE + 31) / 32) * 32;
+
+  SPI spi_;
+  DigitalOut cs_;
+  EventFlags transfer_done_;
+
+  // Static, cache line aligned storage: the controller is heap allocated and
+  // operator new only honours the alignment of members from C++17 on
+  static uint8_t tx_buffer_[DMA_BUFFER_SIZE];
+  static uint8_t rx_buffer_[DMA_BUFFER_SIZE];
+
+  void write_register(uint8_t reg, uint8_t value);
+  uint8_t read_register(uint8_t reg);
+  // reads len bytes starting at reg into rx_buffer_ + 1
+  bool burst_read(uint8_t reg, size_t len);
+  void on_transfer(int event);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // ICM42688_HPP_
@@ -0,0 +1,66 @@
+/**
+ * @file imu_provider.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "imu_provider.hpp"
+#include "ThisThread.h"
+#include <algorithm>
+
+namespace tritonai {
+namespace gkc {
+ImuProvider::ImuProvider(IImuDevice *device) : device_(device) {
+  init_thread_.start(callback(this, &ImuProvider::init_thread_impl));
+}
+
+void ImuProvider::init_thread_impl() {
+  // Each attempt resets the device and sleeps through its power-up, so it
+  // runs here rather than on the sensor poll thread. Without an IMU fitted
+  // the retries back off to IMU_INIT_RETRY_MAX_MS.
+  auto retry = std::chrono::milliseconds(IMU_INIT_RETRY_MS);
+  while (!device_->init()) {
+    ThisThread::sleep_for(retry);
+    retry = std::min(retry * 2, std::chrono::milliseconds(IMU_INIT_RETRY_MAX_MS));
+  }
+  initialized_ = true;
+}
+
+void ImuProvider::populate_reading(SensorGkcPacket &pkt) {
+  const size_t n = device_->read_fifo(batch_, IMU_MAX_BATCH);
+  if (n == 0) {
+    return;
+  }
+
+  // Publish the batch mean, which also acts as an anti-alias filter for
+  // the lower packet rate.
+  float yaw_rate = 0.0f, accel_x = 0.0f, accel_y = 0.0f;
+  for (size_t i = 0; i < n; ++i) {
+    yaw_rate += batch_[i].gyro[2];
+    accel_x += batch_[i].accel[0];
+    accel_y += batch_[i].accel[1];
+  }
+  pkt.imu_yaw_rate = yaw_rate / n;
+  pkt.imu_accel_x = accel_x / n;
+  pkt.imu_accel_y = accel_y / n;
+
+  latest_lock_.lock();
+  latest_ = batch_[n - 1];
+  has_sample_ = true;
+  latest_lock_.unlock();
+}
+
+bool ImuProvider::get_latest(ImuSample &sample) {
+  latest_lock_.lock();
+  const bool has_sample = has_sample_;
+  sample = latest_;
+  latest_lock_.unlock();
+  return has_sample;
+}
+
+} // namespace gkc
+} // namespace tritonai
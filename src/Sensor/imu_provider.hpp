@@ -0,0 +1,78 @@
+/**
+ * @file imu_provider.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Inertial sensing. An IImuDevice buffers samples (in the device FIFO for
+ * real hardware) and hands them over in batches; ImuProvider drains a batch
+ * per poll and publishes yaw rate and planar accelerations.
+ *
+ */
+#ifndef IMU_PROVIDER_HPP_
+#define IMU_PROVIDER_HPP_
+
+#include "Mutex.h"
+#include "Thread.h"
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+
+// Vehicle frame: x forward, y left, z up
+struct ImuSample {
+  uint64_t timestamp_us{0}; // now_us() time of acquisition
+  float accel[3]{};         // m/s^2
+  float gyro[3]{};          // rad/s
+};
+
+class IImuDevice {
+public:
+  IImuDevice() {}
+  // configures the device, returns false if it does not respond
+  virtual bool init() = 0;
+  // drains buffered samples, oldest first, each stamped with its own
+  // acquisition time. Returns the number of samples written.
+  virtual size_t read_fifo(ImuSample *samples, size_t max_samples) = 0;
+};
+
+class ImuProvider : public ISensorProvider {
+public:
+  // brings the device up on a thread of its own, retrying until it answers
+  explicit ImuProvider(IImuDevice *device);
+
+  // ISensorProvider API
+  bool is_ready() override { return initialized_; }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(IMU_POLL_INTERVAL_MS);
+  }
+
+  // copies the newest sample, returns false before the first one
+  bool get_latest(ImuSample &sample);
+
+protected:
+  IImuDevice *device_;
+  std::atomic<bool> initialized_{false};
+  ImuSample batch_[IMU_MAX_BATCH];
+
+  Mutex latest_lock_;
+  ImuSample latest_{};
+  bool has_sample_{false};
+
+  Thread init_thread_{osPriorityBelowNormal, OS_STACK_SIZE, nullptr,
+                      "imu_init_thread"};
+  void init_thread_impl();
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // IMU_PROVIDER_HPP_
@@ -0,0 +1,63 @@
+/**
+ * @file replay_imu.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "replay_imu.hpp"
+
+namespace tritonai {
+namespace gkc {
+const ImuSample IMU_AT_REST_SAMPLES[] = {
+    {0, {0.0f, 0.0f, 9.80665f}, {0.0f, 0.0f, 0.0f}},
+    {1000, {0.0f, 0.0f, 9.80665f}, {0.0f, 0.0f, 0.0f}},
+    {2000, {0.0f, 0.0f, 9.80665f}, {0.0f, 0.0f, 0.0f}},
+    {3000, {0.0f, 0.0f, 9.80665f}, {0.0f, 0.0f, 0.0f}},
+};
+const size_t IMU_AT_REST_SAMPLES_LENGTH =
+    sizeof(IMU_AT_REST_SAMPLES) / sizeof(IMU_AT_REST_SAMPLES[0]);
+
+ReplayImu::ReplayImu(const ImuSample *samples, size_t length)
+    : samples_(samples), length_(length) {
+  if (length_ > 1) {
+    // one extra period so the loop keeps the sample spacing
+    const uint64_t span =
+        samples_[length_ - 1].timestamp_us - samples_[0].timestamp_us;
+    duration_us_ = span + span / (length_ - 1);
+  } else {
+    duration_us_ = 1000;
+  }
+}
+
+bool ReplayImu::init() {
+  start_us_ = now_us();
+  next_ = 0;
+  return length_ > 0;
+}
+
+size_t ReplayImu::read_fifo(ImuSample *samples, size_t max_samples) {
+  const uint64_t now = now_us();
+  size_t count = 0;
+  while (count < max_samples) {
+    const uint64_t due_us = start_us_ + samples_[next_].timestamp_us -
+                            samples_[0].timestamp_us;
+    if (now < due_us) {
+      break;
+    }
+    samples[count] = samples_[next_];
+    samples[count].timestamp_us = due_us;
+    ++count;
+    if (++next_ == length_) {
+      next_ = 0;
+      start_us_ += duration_us_;
+    }
+  }
+  return count;
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,45 @@
+/**
+ * @file replay_imu.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Replays a table of samples in place of the IMU, at the rate of their
+ * timestamps and looping at its end, for benches without the sensor wired
+ * in. The built-in table is synthetic, not a recording.
+ *
+ */
+#ifndef REPLAY_IMU_HPP_
+#define REPLAY_IMU_HPP_
+
+#include "Sensor/imu_provider.hpp"
+
+namespace tritonai {
+namespace gkc {
+
+// Synthetic: the kart at rest and level, gravity only
+extern const ImuSample IMU_AT_REST_SAMPLES[];
+extern const size_t IMU_AT_REST_SAMPLES_LENGTH;
+
+class ReplayImu : public IImuDevice {
+public:
+  // timestamps in the table are relative and evenly spaced
+  ReplayImu(const ImuSample *samples, size_t length);
+
+  // IImuDevice API
+  bool init() override;
+  size_t read_fifo(ImuSample *samples, size_t max_samples) override;
+
+protected:
+  const ImuSample *samples_;
+  size_t length_;
+  uint64_t duration_us_{0};
+  uint64_t start_us_{0};
+  size_t next_{0};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // REPLAY_IMU_HPP_
@@ -0,0 +1,53 @@
+/**
+ * @file sensor_publisher.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "sensor_publisher.hpp"
+#include "ThisThread.h"
+#include "Tools/crash_recorder.hpp"
+#include <iostream>
+
+namespace tritonai {
+namespace gkc {
+SensorPublisher::SensorPublisher(SensorReader *reader, CommManager *comm)
+    : Watchable(SEND_SENSOR_INTERVAL_MS, SEND_SENSOR_LOST_TOLERANCE_MS,
+                "SensorPublisher"),
+      reader_(reader), comm_(comm) {
+  publish_thread.start(
+      callback(this, &SensorPublisher::publish_thread_impl));
+  attach(callback(this, &SensorPublisher::watchdog_callback));
+}
+
+void SensorPublisher::publish_thread_impl() {
+  // Sleep until absolute deadlines so the send time does not accumulate as
+  // drift on top of the interval.
+  auto next_wakeup = Kernel::Clock::now();
+  while (!ThisThread::flags_get()) {
+    if (publishing_) {
+      comm_->send(reader_->get_packet());
+    }
+    this->inc_count();
+
+    next_wakeup += publish_interval_;
+    const auto now = Kernel::Clock::now();
+    if (next_wakeup < now) {
+      // fell behind (e.g. after a rate change), do not burst to catch up
+      next_wakeup = now;
+    }
+    ThisThread::sleep_until(next_wakeup);
+  }
+}
+
+void SensorPublisher::watchdog_callback() {
+  std::cout << "SensorPublisher Timeout detected" << std::endl;
+  CrashRecorder::reset("SensorPublisher watchdog");
+}
+
+} // namespace gkc
+} // namespace tritonai
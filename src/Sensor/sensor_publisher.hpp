@@ -0,0 +1,60 @@
+/**
+ * @file sensor_publisher.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * SensorPublisher streams snapshots of the SensorReader packet to the PC at a
+ * fixed rate. It never holds the provider lock; every published packet is a
+ * tear-free copy taken from the reader's double buffer.
+ *
+ */
+#ifndef SENSOR_PUBLISHER_HPP_
+#define SENSOR_PUBLISHER_HPP_
+
+#include "Comm/comm.hpp"
+#include "Sensor/sensor_reader.hpp"
+#include "Watchdog/watchable.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <atomic>
+#include <chrono>
+
+namespace tritonai {
+namespace gkc {
+
+class SensorPublisher : public Watchable {
+public:
+  SensorPublisher(SensorReader *reader, CommManager *comm);
+
+  // starts or stops streaming, the thread keeps running either way
+  void set_publishing(bool publishing) { publishing_ = publishing; }
+  bool is_publishing() const { return publishing_; }
+
+  // sets the interval between two sensor packets (e.g. 10ms for 100 Hz)
+  void set_publish_interval(std::chrono::milliseconds val) {
+    publish_interval_ = val;
+    set_update_interval(val.count());
+  }
+  std::chrono::milliseconds get_publish_interval() const {
+    return publish_interval_;
+  }
+
+  void watchdog_callback();
+
+protected:
+  SensorReader *reader_;
+  CommManager *comm_;
+  std::atomic<bool> publishing_{false};
+  std::chrono::milliseconds publish_interval_{SEND_SENSOR_INTERVAL_MS};
+
+  Thread publish_thread{osPriorityNormal, OS_STACK_SIZE, nullptr,
+                        "sensor_publish_thread"};
+  void publish_thread_impl();
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SENSOR_PUBLISHER_HPP_
@@ -12,13 +12,17 @@
  * This class "polls" or takes in data from various sensors and updates
  * the sensorGkcPacket object. The register_provider() function adds a sensor
  * while removeProvider() will remove a sensor from the list of readings.
- * This file is a way to read sensor data form multiple sources at a regular interval
+ * This file is a way to read sensor data form multiple sources at a regular interval.
+ * Each provider may ask for its own poll interval; the poll thread keeps a
+ * rate-monotonic timetable and sleeps until the next provider is due.
  */
 
 #include "sensor_reader.hpp"
 #include "ThisThread.h"
 #include "config.hpp"
 #include "Watchdog/watchdog.hpp"
+#include "Tools/crash_recorder.hpp"
+#include <algorithm>
 #include <cstdio>
 #include <string>
 
@@ -37,35 +41,132 @@ SensorReader::SensorReader()
 
 void SensorReader::sensor_poll_thread_impl() {
   while (!ThisThread::flags_get()) {
+    bool polled = false;
     providers_lock_.lock();
-    for (auto &provider : providers_) {
-      if (provider->is_ready()) {
-        provider->populate_reading(pkt_);
+    const auto now = Kernel::Clock::now();
+    const uint64_t poll_time_us = now_us();
+    // Wake up at least every poll_interval_ to keep the watchdog fed
+    auto next_wakeup = now + poll_interval_;
+    for (auto &entry : providers_) {
+      if (entry.next_poll <= now) {
+        if (entry.provider->is_ready()) {
+          entry.provider->populate_reading(pkt_);
+          apply_filters(entry.provider);
+          polled = true;
+        }
+        entry.next_poll += entry.period;
+        if (entry.next_poll <= now) {
+          // Overran a whole period, drop the missed slots instead of
+          // bursting to catch up.
+          entry.next_poll = now + entry.period;
+        }
       }
+      next_wakeup = std::min(next_wakeup, entry.next_poll);
     }
     providers_lock_.unlock();
-    //Waits for a time specified by poll_interval
+    if (polled) {
+      publish_snapshot(poll_time_us);
+    }
     this->inc_count(); // Increments the count of the watchdog
-    ThisThread::sleep_for(poll_interval_);
+    //Waits until the next provider is due
+    ThisThread::sleep_until(next_wakeup);
+  }
+}
+
+std::chrono::milliseconds
+SensorReader::period_of(const ISensorProvider *provider) const {
+  const auto requested = provider->get_poll_interval();
+  return requested > std::chrono::milliseconds::zero() ? requested
+                                                       : poll_interval_;
+}
+
+void SensorReader::sort_schedule() {
+  std::stable_sort(providers_.begin(), providers_.end(),
+                   [](const ScheduledProvider &a, const ScheduledProvider &b) {
+                     const bool a_records = a.provider->is_recorder();
+                     const bool b_records = b.provider->is_recorder();
+                     if (a_records != b_records) {
+                       return b_records;
+                     }
+                     return a.period < b.period;
+                   });
+}
+
+void SensorReader::set_poll_interval(std::chrono::milliseconds val) {
+  providers_lock_.lock();
+  poll_interval_ = val;
+  for (auto &entry : providers_) {
+    entry.period = period_of(entry.provider);
+  }
+  sort_schedule();
+  providers_lock_.unlock();
+}
+
+void SensorReader::publish_snapshot(uint64_t timestamp_us) {
+  const uint32_t next = snapshot_seq_.load(std::memory_order_relaxed) + 1;
+  snapshots_[next & 1] = pkt_;
+  snapshot_time_us_[next & 1] = timestamp_us;
+  snapshot_seq_.store(next, std::memory_order_release);
+}
+
+SensorGkcPacket SensorReader::get_packet(uint64_t *timestamp_us) const {
+  SensorGkcPacket copy;
+  uint64_t copy_time_us;
+  while (true) {
+    const uint32_t seq = snapshot_seq_.load(std::memory_order_acquire);
+    copy = snapshots_[seq & 1];
+    copy_time_us = snapshot_time_us_[seq & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The writer only ever fills the inactive slot, so our slot can only be
+    // overwritten after the sequence has moved on. A preempted writer never
+    // blocks us, it is busy with the other slot.
+    if (snapshot_seq_.load(std::memory_order_relaxed) == seq) {
+      if (timestamp_us != nullptr) {
+        *timestamp_us = copy_time_us;
+      }
+      return copy;
+    }
   }
 }
 
 void SensorReader::register_provider(ISensorProvider *provider) {
   providers_lock_.lock();
-  providers_.push_back(provider);
+  providers_.push_back(
+      ScheduledProvider{provider, period_of(provider), Kernel::Clock::now()});
+  sort_schedule();
   providers_lock_.unlock();
 }
 
 void SensorReader::remove_provider(ISensorProvider *provider) {
   providers_lock_.lock();
-  providers_.erase(std::remove(providers_.begin(), providers_.end(), provider),
+  providers_.erase(std::remove_if(providers_.begin(), providers_.end(),
+                                  [provider](const ScheduledProvider &entry) {
+                                    return entry.provider == provider;
+                                  }),
                    providers_.end());
   providers_lock_.unlock();
 }
 
+void SensorReader::add_filter(ISensorProvider *source,
+                              float SensorGkcPacket::*channel,
+                              const FilterSpec &spec) {
+  providers_lock_.lock();
+  const float sample_hz = 1000.0f / period_of(source).count();
+  filters_.push_back(ChannelFilter{source, channel, SignalFilter(spec, sample_hz)});
+  providers_lock_.unlock();
+}
+
+void SensorReader::apply_filters(const ISensorProvider *source) {
+  for (auto &entry : filters_) {
+    if (entry.source == source) {
+      pkt_.*entry.channel = entry.filter.process(pkt_.*entry.channel);
+    }
+  }
+}
+
 void SensorReader::watchdog_callback() {
   std::cout << "SensorReader Timeout detected" << std::endl;
-  NVIC_SystemReset();
+  CrashRecorder::reset("SensorReader watchdog");
 }
 
 } // namespace gkc
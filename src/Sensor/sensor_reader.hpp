@@ -19,6 +19,9 @@
 #include "config.hpp"//Header file containing communication and watchdog parameters and allocates CAN busses for Throttle, brakaing and steering
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "Watchdog/watchable.hpp"
+#include "Tools/timebase.hpp"
+#include "Sensor/signal_filter.hpp"
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <vector>
@@ -31,10 +34,21 @@ public:
   ISensorProvider() {}
   //is_ready os a boolean function that indicates
   //whether the sensor is ready to be read
+  //It must be a cheap query without side effects: the poll thread and
+  //the consumers of a provider call it at any time.
   virtual bool is_ready() = 0;
   //populate_reading "populates" the SensorGkcPacket
   // with sensor data a the address of pkt
   virtual void populate_reading(SensorGkcPacket &pkt) = 0;
+  //get_poll_interval is how often the provider wants to be polled.
+  //Zero means the reader's default poll interval.
+  virtual std::chrono::milliseconds get_poll_interval() const {
+    return std::chrono::milliseconds::zero();
+  }
+  //is_recorder marks a provider that only reads the packet. Recorders are
+  //polled after every other provider due in the same cycle, so they see
+  //this cycle's values.
+  virtual bool is_recorder() const { return false; }
 };
 
 class SensorReader : public Watchable {
@@ -42,26 +56,57 @@ public:
   SensorReader();
   void register_provider(ISensorProvider *provider);
   void remove_provider(ISensorProvider *provider);
-  const SensorGkcPacket &get_packet() const { return pkt_; }
-  //populates poll_interval with millisecond value in val.
-  void set_poll_interval(std::chrono::milliseconds val) {
-    poll_interval_ = val;
-  }
+  // filters channel every time source has populated it, at the rate
+  // source is polled. Register source first.
+  void add_filter(ISensorProvider *source, float SensorGkcPacket::*channel,
+                  const FilterSpec &spec);
+  // returns a consistent copy of the last fully populated packet,
+  // safe to call from any thread. timestamp_us receives the now_us() time
+  // the providers were polled.
+  SensorGkcPacket get_packet(uint64_t *timestamp_us = nullptr) const;
+  //populates poll_interval with millisecond value in val. This is the
+  //default for providers that do not ask for a rate of their own.
+  void set_poll_interval(std::chrono::milliseconds val);
   std::chrono::milliseconds get_poll_interval() { return poll_interval_; }
 
   void watchdog_callback();
 
 protected:
+  // working packet, only touched by the poll thread
   SensorGkcPacket pkt_{};
-  std::vector<ISensorProvider *> providers_{};
+  // double buffer of published snapshots. The poll thread copies pkt_ into
+  // the inactive slot and then bumps snapshot_seq_, whose lowest bit selects
+  // the active slot. Readers retry if the sequence moved during their copy.
+  SensorGkcPacket snapshots_[2]{};
+  uint64_t snapshot_time_us_[2]{};
+  std::atomic<uint32_t> snapshot_seq_{0};
+  void publish_snapshot(uint64_t timestamp_us);
+
+  // Rate-monotonic timetable: providers are kept sorted by period so the
+  // fastest ones are served first whenever several are due at once.
+  // Recorders come after all of them.
+  struct ScheduledProvider {
+    ISensorProvider *provider;
+    std::chrono::milliseconds period;
+    Kernel::Clock::time_point next_poll;
+  };
+  std::vector<ScheduledProvider> providers_{};
   Mutex providers_lock_;
+  std::chrono::milliseconds period_of(const ISensorProvider *provider) const;
+  void sort_schedule();
   std::chrono::milliseconds poll_interval_{DEFAULT_SENSOR_POLL_INTERVAL_MS};
 
-  Thread sensor_poll_thread{osPriorityNormal, OS_STACK_SIZE, nullptr,
+  struct ChannelFilter {
+    ISensorProvider *source;
+    float SensorGkcPacket::*channel;
+    SignalFilter filter;
+  };
+  std::vector<ChannelFilter> filters_{};
+  void apply_filters(const ISensorProvider *source);
+
+  Thread sensor_poll_thread{osPriorityAboveNormal, OS_STACK_SIZE, nullptr,
                             "sensor_poll_thread"};
   void sensor_poll_thread_impl();
-
-  // TODO include QEI.h and add a pointer to qei
 };
 } // namespace gkc
 } // namespace tritonai
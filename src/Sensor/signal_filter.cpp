@@ -0,0 +1,104 @@
+/**
+ * @file signal_filter.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "signal_filter.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+constexpr float PI = 3.14159265358979f;
+constexpr float BUTTERWORTH_Q = 0.70710678f;
+} // namespace
+
+// Coefficients from the RBJ audio EQ cookbook
+Biquad Biquad::lowpass(float sample_hz, float cutoff_hz) {
+  Biquad f;
+  const float w0 = 2.0f * PI * cutoff_hz / sample_hz;
+  const float cos_w0 = std::cos(w0);
+  const float alpha = std::sin(w0) / (2.0f * BUTTERWORTH_Q);
+  const float a0 = 1.0f + alpha;
+  f.coeffs_[0] = (1.0f - cos_w0) / 2.0f / a0;
+  f.coeffs_[1] = (1.0f - cos_w0) / a0;
+  f.coeffs_[2] = f.coeffs_[0];
+  f.coeffs_[3] = 2.0f * cos_w0 / a0;
+  f.coeffs_[4] = -(1.0f - alpha) / a0;
+  return f;
+}
+
+Biquad Biquad::notch(float sample_hz, float center_hz, float q) {
+  Biquad f;
+  const float w0 = 2.0f * PI * center_hz / sample_hz;
+  const float cos_w0 = std::cos(w0);
+  const float alpha = std::sin(w0) / (2.0f * q);
+  const float a0 = 1.0f + alpha;
+  f.coeffs_[0] = 1.0f / a0;
+  f.coeffs_[1] = -2.0f * cos_w0 / a0;
+  f.coeffs_[2] = f.coeffs_[0];
+  f.coeffs_[3] = 2.0f * cos_w0 / a0;
+  f.coeffs_[4] = -(1.0f - alpha) / a0;
+  return f;
+}
+
+float Biquad::process(float x) {
+  const float y = coeffs_[0] * x + state_[0];
+  state_[0] = coeffs_[1] * x + coeffs_[3] * y + state_[1];
+  state_[1] = coeffs_[2] * x + coeffs_[4] * y;
+  return y;
+}
+
+void Biquad::prime(float x) {
+  // both filter types have unity DC gain, so the steady state output is x
+  state_[1] = coeffs_[2] * x + coeffs_[4] * x;
+  state_[0] = coeffs_[1] * x + coeffs_[3] * x + state_[1];
+}
+
+MovingMedian::MovingMedian(size_t window)
+    : window_(std::min(std::max<size_t>(window, 1), size_t{MAX_WINDOW})) {}
+
+float MovingMedian::process(float x) {
+  history_[next_] = x;
+  next_ = (next_ + 1) % window_;
+  if (window_ == 1) {
+    return x;
+  }
+  float sorted[MAX_WINDOW];
+  std::copy(history_, history_ + window_, sorted);
+  std::nth_element(sorted, sorted + window_ / 2, sorted + window_);
+  return sorted[window_ / 2];
+}
+
+void MovingMedian::prime(float x) { std::fill(history_, history_ + window_, x); }
+
+SignalFilter::SignalFilter(const FilterSpec &spec, float sample_hz)
+    : median_(spec.median_window) {
+  // stages above Nyquist would be unstable, leave them out
+  if (spec.notch_hz > 0.0f && spec.notch_hz < sample_hz / 2.0f) {
+    notch_ = Biquad::notch(sample_hz, spec.notch_hz, spec.notch_q);
+  }
+  if (spec.lowpass_hz > 0.0f && spec.lowpass_hz < sample_hz / 2.0f) {
+    lowpass_ = Biquad::lowpass(sample_hz, spec.lowpass_hz);
+  }
+}
+
+float SignalFilter::process(float x) {
+  if (!primed_) {
+    // start from the first reading instead of ramping up from zero
+    median_.prime(x);
+    notch_.prime(x);
+    lowpass_.prime(x);
+    primed_ = true;
+  }
+  return lowpass_.process(notch_.process(median_.process(x)));
+}
+
+} // namespace gkc
+} // namespace tritonai
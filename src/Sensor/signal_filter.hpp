@@ -0,0 +1,80 @@
+/**
+ * @file signal_filter.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Streaming filters for single sensor channels: moving median for spikes,
+ * biquad notch and low-pass for noise. The biquads run the transposed
+ * direct form II recurrence in plain C++, one sample per call, where a
+ * CMSIS-DSP kernel would gain nothing.
+ *
+ */
+#ifndef SIGNAL_FILTER_HPP_
+#define SIGNAL_FILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+
+class Biquad {
+public:
+  // pass-through
+  Biquad() {}
+  // 2nd order Butterworth low-pass
+  static Biquad lowpass(float sample_hz, float cutoff_hz);
+  // band-stop around center_hz, q sets how narrow it is
+  static Biquad notch(float sample_hz, float center_hz, float q);
+
+  float process(float x);
+  // sets the state as if x had been applied forever
+  void prime(float x);
+
+private:
+  // b0, b1, b2, -a1, -a2 (a0 normalized to 1)
+  float coeffs_[5]{1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float state_[2]{};
+};
+
+class MovingMedian {
+public:
+  static constexpr size_t MAX_WINDOW = 9;
+
+  explicit MovingMedian(size_t window = 1);
+  float process(float x);
+  void prime(float x);
+
+private:
+  size_t window_;
+  size_t next_{0};
+  float history_[MAX_WINDOW]{};
+};
+
+// Zero disables a stage
+struct FilterSpec {
+  uint8_t median_window{0};
+  float notch_hz{0.0f};
+  float notch_q{2.0f};
+  float lowpass_hz{0.0f};
+};
+
+// median, then notch, then low-pass
+class SignalFilter {
+public:
+  SignalFilter(const FilterSpec &spec, float sample_hz);
+  float process(float x);
+
+private:
+  MovingMedian median_;
+  Biquad notch_;
+  Biquad lowpass_;
+  bool primed_{false};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SIGNAL_FILTER_HPP_
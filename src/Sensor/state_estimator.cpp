@@ -0,0 +1,127 @@
+/**
+ * @file state_estimator.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "state_estimator.hpp"
+#include "Actuation/steering_map.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+// a poll that comes this late restarts the filter rather than integrating
+constexpr float MAX_DT_S = 0.1f;
+// keeps v * (1 + s) from flipping sign through the slip state
+constexpr float MIN_SLIP = -0.9f;
+constexpr float MAX_SLIP = 2.0f;
+
+constexpr float ERPM_TO_MS =
+    WHEEL_CIRCUMFERENCE_M / (MOTOR_POLE_PAIRS * DRIVE_GEAR_RATIO * 60.0f);
+} // namespace
+
+void StateEstimator::populate_reading(SensorGkcPacket &pkt) {
+  const uint64_t now = now_us();
+  const float dt = (now - last_update_us_) * 1e-6f;
+  last_update_us_ = now;
+  bool has_imu = false;
+  if (!started_ || dt > MAX_DT_S) {
+    x_ = Matrix<N, 1>();
+    P_ = Matrix<N, N>::identity();
+    started_ = true;
+  } else {
+    has_imu = usable(imu_);
+    predict(dt, has_imu ? pkt.imu_accel_x : 0.0f);
+
+    if (usable(wheel_)) {
+      correct_wheel_speed(0.5f * (pkt.wheel_speed_rl + pkt.wheel_speed_rr),
+                          EST_R_WHEEL);
+    }
+    if (usable(motor_)) {
+      correct_wheel_speed(pkt.motor_erpm * ERPM_TO_MS, EST_R_MOTOR);
+    }
+    if (has_imu) {
+      Matrix<1, N> H;
+      H(0, YAW_RATE) = 1.0f;
+      correct(H, pkt.imu_yaw_rate - x_(YAW_RATE, 0), EST_R_GYRO);
+    }
+    if (usable(steering_)) {
+      // pseudo-measurement 0 = r - v tan(delta) / L
+      const float k =
+          std::tan(map_motor2steer(pkt.steering_angle_rad)) / WHEELBASE_M;
+      Matrix<1, N> H;
+      H(0, SPEED) = -k;
+      H(0, YAW_RATE) = 1.0f;
+      correct(H, -(x_(YAW_RATE, 0) - k * x_(SPEED, 0)), EST_R_KINEMATIC);
+    }
+    Matrix<1, N> H;
+    H(0, SLIP) = 1.0f;
+    correct(H, -x_(SLIP, 0), EST_R_SLIP_PRIOR);
+  }
+
+  pkt.est_speed = x_(SPEED, 0);
+  pkt.est_yaw_rate = x_(YAW_RATE, 0);
+  pkt.est_slip = x_(SLIP, 0);
+  ground_speed_ = x_(SPEED, 0);
+  ground_speed_valid_ = has_imu;
+}
+
+void StateEstimator::predict(float dt, float accel) {
+  // Speed integrates the measured acceleration, yaw rate and slip are
+  // random walks, so the transition is the identity.
+  x_(SPEED, 0) += accel * dt;
+  P_(SPEED, SPEED) += EST_Q_SPEED * dt;
+  P_(YAW_RATE, YAW_RATE) += EST_Q_YAW_RATE * dt;
+  P_(SLIP, SLIP) += EST_Q_SLIP * dt;
+}
+
+void StateEstimator::correct_wheel_speed(float measured, float variance) {
+  const float v = x_(SPEED, 0);
+  const float s = x_(SLIP, 0);
+  Matrix<1, N> H;
+  H(0, SPEED) = 1.0f + s;
+  H(0, SLIP) = v;
+  correct(H, measured - v * (1.0f + s), variance);
+}
+
+void StateEstimator::correct(const Matrix<1, N> &H, float innovation,
+                             float variance) {
+  Matrix<N, 1> Ht;
+  Matrix<N, 1> PHt;
+  Matrix<1, 1> S;
+  mat_trans(H, Ht);
+  mat_mult(P_, Ht, PHt);
+  mat_mult(H, PHt, S);
+  const float inv_s = 1.0f / (S(0, 0) + variance);
+
+  // K = P H^T / S; P is symmetric so H P = (P H^T)^T
+  Matrix<N, 1> K;
+  for (size_t i = 0; i < N; ++i) {
+    K(i, 0) = PHt(i, 0) * inv_s;
+    x_(i, 0) += K(i, 0) * innovation;
+  }
+  Matrix<1, N> HP;
+  Matrix<N, N> KHP;
+  mat_trans(PHt, HP);
+  mat_mult(K, HP, KHP);
+  mat_sub(P_, KHP, P_);
+
+  // rounding slowly breaks the symmetry the update relies on
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = i + 1; j < N; ++j) {
+      const float mean = 0.5f * (P_(i, j) + P_(j, i));
+      P_(i, j) = mean;
+      P_(j, i) = mean;
+    }
+  }
+  x_(SLIP, 0) = std::min(std::max(x_(SLIP, 0), MIN_SLIP), MAX_SLIP);
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,94 @@
+/**
+ * @file state_estimator.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Extended Kalman filter over the planar vehicle state, run as the last
+ * provider of the sensor poll so it sees the readings of the same cycle.
+ *
+ * State: forward speed v (m/s), yaw rate r (rad/s) and slip s of the driven
+ * rear wheels, with wheel surface speed v * (1 + s). The IMU forward
+ * acceleration drives the prediction; wheel encoder, motor ERPM, gyro and
+ * the bicycle model (r = v tan(delta) / L) correct it one scalar
+ * measurement at a time. Speed and slip separate through the IMU and the
+ * steering geometry, a weak prior keeps slip at zero otherwise.
+ *
+ * Only with the IMU is the speed estimate a ground speed of its own; the
+ * other sensors all turn with the driven wheels. The prior still pulls it
+ * towards the wheel speed during a long spin, so it is a reference for
+ * short launches and braking, not for sustained wheelspin.
+ *
+ */
+#ifndef STATE_ESTIMATOR_HPP_
+#define STATE_ESTIMATOR_HPP_
+
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/small_matrix.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+
+class StateEstimator : public ISensorProvider {
+public:
+  StateEstimator() {}
+
+  // Attach the providers whose readings are fused. Each one is only used
+  // while it is ready; missing sensors are simply left out.
+  void use_motor(ISensorProvider *motor) { motor_ = motor; }
+  void use_wheel(ISensorProvider *wheel) { wheel_ = wheel; }
+  void use_steering(ISensorProvider *steering) { steering_ = steering; }
+  void use_imu(ISensorProvider *imu) { imu_ = imu; }
+
+  // ISensorProvider API
+  bool is_ready() override { return true; }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(EST_POLL_INTERVAL_MS);
+  }
+
+  // Estimated forward speed in m/s. False unless the last update fused the
+  // IMU, without it the estimate is the speed of the driven wheels. Safe to
+  // call from any thread.
+  bool get_ground_speed(float &speed) const {
+    speed = ground_speed_.load();
+    return ground_speed_valid_.load();
+  }
+
+protected:
+  static constexpr size_t N = 3;
+  enum StateIndex { SPEED = 0, YAW_RATE = 1, SLIP = 2 };
+
+  ISensorProvider *motor_{nullptr};
+  ISensorProvider *wheel_{nullptr};
+  ISensorProvider *steering_{nullptr};
+  ISensorProvider *imu_{nullptr};
+
+  Matrix<N, 1> x_;
+  Matrix<N, N> P_;
+  uint64_t last_update_us_{0};
+  bool started_{false};
+  std::atomic<float> ground_speed_{0.0f};
+  std::atomic<bool> ground_speed_valid_{false};
+
+  void predict(float dt, float accel);
+  // scalar EKF correction with measurement Jacobian H
+  void correct(const Matrix<1, N> &H, float innovation, float variance);
+  // wheel surface speed measurement, v * (1 + s)
+  void correct_wheel_speed(float measured, float variance);
+
+  static bool usable(ISensorProvider *source) {
+    return source != nullptr && source->is_ready();
+  }
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // STATE_ESTIMATOR_HPP_
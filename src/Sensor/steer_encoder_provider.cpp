@@ -0,0 +1,19 @@
+/**
+ * @file steer_encoder_provider.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "steer_encoder_provider.hpp"
+
+namespace tritonai {
+namespace gkc {
+void SteerEncoderProvider::populate_reading(SensorGkcPacket &pkt) {
+  pkt.steering_angle_rad = get_angle();
+}
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,60 @@
+/**
+ * @file steer_encoder_provider.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Steering column angle from the absolute PWM encoder on STEER_ENCODER_PIN.
+ *
+ */
+#ifndef STEER_ENCODER_PROVIDER_HPP_
+#define STEER_ENCODER_PROVIDER_HPP_
+
+#include "PwmIn.h"
+#include "PwmInCapture.h"
+#include "Sensor/sensor_reader.hpp"
+#include "config.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace tritonai {
+namespace gkc {
+
+#ifdef STEER_ENCODER_USE_CAPTURE
+typedef PwmInCapture SteerEncoder;
+#else
+typedef PwmIn SteerEncoder;
+#endif
+
+class SteerEncoderProvider : public ISensorProvider {
+public:
+  SteerEncoderProvider() : encoder_(STEER_ENCODER_PIN) {}
+
+  // ISensorProvider API
+  bool is_ready() override { return encoder_.period() > 0.0f; }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(STEER_ENCODER_POLL_INTERVAL_MS);
+  }
+
+  // steering column angle in radians, positive to the left
+  float get_angle() { return get_raw_angle() - center_; }
+  // the same, before the calibrated center is taken off
+  float get_raw_angle() { return duty_to_angle(encoder_.dutycycle()); }
+  // raw angle of the column with the wheels straight
+  void set_center(float center) { center_ = center; }
+
+protected:
+  SteerEncoder encoder_;
+  std::atomic<float> center_{0.0f};
+
+  static float duty_to_angle(float duty) {
+    return (duty - STEER_ENCODER_CENTER_DUTY) * STEER_ENCODER_RAD_PER_DUTY;
+  }
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // STEER_ENCODER_PROVIDER_HPP_
@@ -0,0 +1,180 @@
+/**
+ * @file vesc_status_provider.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "vesc_status_provider.hpp"
+#include "Actuation/can_bus.hpp"
+#include "ThisThread.h"
+
+namespace tritonai {
+namespace gkc {
+namespace {
+// VESC frames are big endian
+int16_t buffer_get_int16(const uint8_t *buffer, int32_t *index) {
+  const int16_t res = ((uint16_t)buffer[*index] << 8) |
+                      ((uint16_t)buffer[*index + 1]);
+  *index += 2;
+  return res;
+}
+
+int32_t buffer_get_int32(const uint8_t *buffer, int32_t *index) {
+  const int32_t res = ((uint32_t)buffer[*index] << 24) |
+                      ((uint32_t)buffer[*index + 1] << 16) |
+                      ((uint32_t)buffer[*index + 2] << 8) |
+                      ((uint32_t)buffer[*index + 3]);
+  *index += 4;
+  return res;
+}
+
+float buffer_get_float16(const uint8_t *buffer, float scale, int32_t *index) {
+  return (float)buffer_get_int16(buffer, index) / scale;
+}
+
+float buffer_get_float32(const uint8_t *buffer, float scale, int32_t *index) {
+  return (float)buffer_get_int32(buffer, index) / scale;
+}
+} // namespace
+
+VescStatusProvider::VescStatusProvider(uint8_t port, uint8_t telemetry_id)
+    : telemetry_id_(telemetry_id), port_(port), can_(can_port(port)) {
+  rx_thread_.start(callback(this, &VescStatusProvider::rx_thread_impl));
+  can_.attach(callback(this, &VescStatusProvider::rx_irq), CAN::RxIrq);
+}
+
+bool VescStatusProvider::add_node(uint8_t vesc_id) {
+  status_lock_.lock();
+  if (find_node(vesc_id)) {
+    status_lock_.unlock();
+    return true;
+  }
+  if (num_nodes_ == MAX_NODES) {
+    status_lock_.unlock();
+    return false;
+  }
+  // Status frames carry the packet ID in bits 8-15 and the sender's
+  // controller ID in bits 0-7. Match the sender only.
+  if (!can_add_filter(port_, vesc_id, 0xFF)) {
+    status_lock_.unlock();
+    return false;
+  }
+  nodes_[num_nodes_].id = vesc_id;
+  nodes_[num_nodes_].status = VescStatus{};
+  ++num_nodes_;
+  status_lock_.unlock();
+  return true;
+}
+
+bool VescStatusProvider::get_status(uint8_t vesc_id, VescStatus &status) {
+  status_lock_.lock();
+  const Node *node = find_node(vesc_id);
+  const bool found = node && node->status.received;
+  if (found) {
+    status = node->status;
+  }
+  status_lock_.unlock();
+  return found;
+}
+
+bool VescStatusProvider::is_ready() {
+  VescStatus status;
+  if (!get_status(telemetry_id_, status)) {
+    return false;
+  }
+  return now_us() - status.timestamp_us < VESC_STATUS_TIMEOUT_MS * 1000ull;
+}
+
+void VescStatusProvider::populate_reading(SensorGkcPacket &pkt) {
+  VescStatus status;
+  if (!get_status(telemetry_id_, status)) {
+    return;
+  }
+  pkt.motor_erpm = status.erpm;
+  pkt.motor_current = status.current;
+  pkt.motor_duty_cycle = status.duty_cycle;
+  pkt.motor_tachometer = status.tachometer;
+  pkt.supply_voltage = status.voltage_in;
+  pkt.motor_temperature = status.temp_motor;
+  pkt.controller_temperature = status.temp_fet;
+}
+
+VescStatusProvider::Node *VescStatusProvider::find_node(uint8_t vesc_id) {
+  for (size_t i = 0; i < num_nodes_; ++i) {
+    if (nodes_[i].id == vesc_id) {
+      return &nodes_[i];
+    }
+  }
+  return nullptr;
+}
+
+void VescStatusProvider::rx_irq() {
+  // ISR context: CAN::read takes a mutex, leave the work to the thread
+  rx_thread_.flags_set(RX_FLAG);
+}
+
+void VescStatusProvider::rx_thread_impl() {
+  CANMessage msg;
+  while (true) {
+    ThisThread::flags_wait_any(RX_FLAG);
+    while (can_.read(msg)) {
+      can_count_rx(port_, msg);
+      if (msg.format == CANExtended) {
+        decode(msg, now_us());
+      }
+    }
+  }
+}
+
+void VescStatusProvider::decode(const CANMessage &msg, uint64_t arrival_us) {
+  const uint8_t vesc_id = msg.id & 0xFF;
+  const uint8_t packet_id = (msg.id >> 8) & 0xFF;
+  int32_t index = 0;
+
+  status_lock_.lock();
+  Node *node = find_node(vesc_id);
+  if (!node || msg.len < 8) {
+    status_lock_.unlock();
+    return;
+  }
+  VescStatus &status = node->status;
+  switch (packet_id) {
+  case CAN_PACKET_STATUS:
+    status.erpm = (float)buffer_get_int32(msg.data, &index);
+    status.current = buffer_get_float16(msg.data, 1e1, &index);
+    status.duty_cycle = buffer_get_float16(msg.data, 1e3, &index);
+    break;
+  case CAN_PACKET_STATUS_2:
+    status.amp_hours = buffer_get_float32(msg.data, 1e4, &index);
+    status.amp_hours_charged = buffer_get_float32(msg.data, 1e4, &index);
+    break;
+  case CAN_PACKET_STATUS_3:
+    status.watt_hours = buffer_get_float32(msg.data, 1e4, &index);
+    status.watt_hours_charged = buffer_get_float32(msg.data, 1e4, &index);
+    break;
+  case CAN_PACKET_STATUS_4:
+    status.temp_fet = buffer_get_float16(msg.data, 1e1, &index);
+    status.temp_motor = buffer_get_float16(msg.data, 1e1, &index);
+    status.current_in = buffer_get_float16(msg.data, 1e1, &index);
+    status.pid_pos = buffer_get_float16(msg.data, 50.0, &index);
+    break;
+  case CAN_PACKET_STATUS_5:
+    status.tachometer = buffer_get_int32(msg.data, &index);
+    status.voltage_in = buffer_get_float16(msg.data, 1e1, &index);
+    break;
+  default:
+    // a command echoed by another node, or a packet we do not decode
+    status_lock_.unlock();
+    return;
+  }
+  status.received = true;
+  status.timestamp_us = arrival_us;
+  status_lock_.unlock();
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,106 @@
+/**
+ * @file vesc_status_provider.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Receives the CAN_PACKET_STATUS 1-5 broadcasts of the VESCs on one CAN bus.
+ * Every registered controller ID gets its own hardware acceptance filter, so
+ * unrelated traffic never reaches the CPU. The RX interrupt only wakes the
+ * receive thread, which drains the FIFO and decodes the frames.
+ *
+ */
+#ifndef VESC_STATUS_PROVIDER_HPP_
+#define VESC_STATUS_PROVIDER_HPP_
+
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+
+// VESC status packet IDs, see comm_can.c of the VESC firmware
+enum VescStatusPacketId : uint8_t {
+  CAN_PACKET_STATUS = 9,
+  CAN_PACKET_STATUS_2 = 14,
+  CAN_PACKET_STATUS_3 = 15,
+  CAN_PACKET_STATUS_4 = 16,
+  CAN_PACKET_STATUS_5 = 27,
+};
+
+struct VescStatus {
+  // CAN_PACKET_STATUS
+  float erpm{0.0f};
+  float current{0.0f}; // A
+  float duty_cycle{0.0f};
+  // CAN_PACKET_STATUS_2 and 3
+  float amp_hours{0.0f};
+  float amp_hours_charged{0.0f};
+  float watt_hours{0.0f};
+  float watt_hours_charged{0.0f};
+  // CAN_PACKET_STATUS_4
+  float temp_fet{0.0f};   // degC
+  float temp_motor{0.0f}; // degC
+  float current_in{0.0f}; // A
+  float pid_pos{0.0f};    // deg
+  // CAN_PACKET_STATUS_5
+  int32_t tachometer{0};
+  float voltage_in{0.0f}; // V
+
+  bool received{false};
+  uint64_t timestamp_us{0}; // now_us() time the last frame arrived
+};
+
+class VescStatusProvider : public ISensorProvider {
+public:
+  // telemetry_id selects the VESC whose status goes into the sensor packet
+  explicit VescStatusProvider(uint8_t port,
+                              uint8_t telemetry_id = THROTTLE_CAN_ID);
+
+  // starts listening to a VESC, returns false if all filter slots are used
+  bool add_node(uint8_t vesc_id);
+  // copies the last status of a VESC, returns false if it is unknown
+  bool get_status(uint8_t vesc_id, VescStatus &status);
+  uint8_t get_port() const { return port_; }
+
+  // ISensorProvider API
+  bool is_ready() override;
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(VESC_STATUS_POLL_INTERVAL_MS);
+  }
+
+protected:
+  static constexpr size_t MAX_NODES = 4;
+  static constexpr uint32_t RX_FLAG = 0x1;
+
+  struct Node {
+    uint8_t id;
+    VescStatus status;
+  };
+  Node nodes_[MAX_NODES]{};
+  size_t num_nodes_{0};
+  uint8_t telemetry_id_;
+
+  uint8_t port_;
+  CAN &can_;
+  Mutex status_lock_;
+  Thread rx_thread_{osPriorityHigh, OS_STACK_SIZE, nullptr, "vesc_rx_thread"};
+
+  Node *find_node(uint8_t vesc_id);
+  void rx_irq();
+  void rx_thread_impl();
+  // arrival_us is the now_us() time the frame was taken off the bus
+  void decode(const CANMessage &msg, uint64_t arrival_us);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // VESC_STATUS_PROVIDER_HPP_
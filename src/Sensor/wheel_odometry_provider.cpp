@@ -0,0 +1,66 @@
+/**
+ * @file wheel_odometry_provider.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "wheel_odometry_provider.hpp"
+#include "hal/us_ticker_api.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace tritonai {
+namespace gkc {
+WheelOdometryProvider::WheelOdometryProvider()
+    : encoder_(WHEEL_ENCODER_A_PIN, WHEEL_ENCODER_B_PIN, NC,
+               WHEEL_ENCODER_PPR, QEI::X4_ENCODING),
+      meters_per_pulse_(WHEEL_CIRCUMFERENCE_M / (4.0f * WHEEL_ENCODER_PPR)) {}
+
+void WheelOdometryProvider::populate_reading(SensorGkcPacket &pkt) {
+  int pulses;
+  uint32_t last_pulse_us;
+  int32_t period_us;
+  encoder_.getPulseTiming(pulses, last_pulse_us, period_us);
+  const uint32_t now = us_ticker_read();
+  const uint32_t since_last_pulse = now - last_pulse_us;
+
+  if (period_us == 0 ||
+      since_last_pulse > WHEEL_ODOMETRY_STOP_TIMEOUT_MS * 1000u) {
+    // Standing still (or just reversed), restart counting at the last edge
+    speed_ = 0.0f;
+    window_pulses_ = pulses;
+    window_start_us_ = last_pulse_us;
+  } else if (std::abs(pulses - window_pulses_) >=
+             WHEEL_ODOMETRY_MIN_COUNT_PULSES) {
+    // High speed: pulses counted between two edges. Both ends of the window
+    // are edge times, so the poll period adds no quantization error.
+    const float window_s = (last_pulse_us - window_start_us_) * 1e-6f;
+    speed_ = (pulses - window_pulses_) * meters_per_pulse_ / window_s;
+    window_pulses_ = pulses;
+    window_start_us_ = last_pulse_us;
+  } else {
+    // Low speed: one pulse period. Until the next pulse arrives, the time
+    // since the last one bounds the speed from above, so a wheel coming to a
+    // stop decays smoothly instead of holding its last speed.
+    const uint32_t period =
+        std::max<uint32_t>(std::abs(period_us), since_last_pulse);
+    speed_ = std::copysign(meters_per_pulse_ / (period * 1e-6f),
+                           static_cast<float>(period_us));
+  }
+
+  distance_ = pulses * meters_per_pulse_;
+  timestamp_us_ = now_us();
+
+  // The encoder sits on the solid rear axle
+  pkt.wheel_speed_rl = speed_;
+  pkt.wheel_speed_rr = speed_;
+  pkt.wheel_distance = distance_;
+}
+
+} // namespace gkc
+} // namespace tritonai
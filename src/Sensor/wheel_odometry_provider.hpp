@@ -0,0 +1,66 @@
+/**
+ * @file wheel_odometry_provider.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Wheel odometry from the quadrature encoder on the rear axle. Speed is
+ * estimated from the pulse count between two edges when enough pulses arrive
+ * per poll, and from the period of the last pulse at low speed, where
+ * counting would only see zero or one pulse per poll.
+ *
+ */
+#ifndef WHEEL_ODOMETRY_PROVIDER_HPP_
+#define WHEEL_ODOMETRY_PROVIDER_HPP_
+
+#include "QEI.hpp"
+#include "QEITimer.hpp"
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+
+#ifdef WHEEL_ENCODER_USE_TIMER
+typedef QEITimer WheelEncoder;
+#else
+typedef QEI WheelEncoder;
+#endif
+
+class WheelOdometryProvider : public ISensorProvider {
+public:
+  WheelOdometryProvider();
+
+  // ISensorProvider API
+  bool is_ready() override { return true; }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(WHEEL_ODOMETRY_POLL_INTERVAL_MS);
+  }
+
+  float get_speed() const { return speed_; }       // m/s
+  float get_distance() const { return distance_; } // m
+  // now_us() time at which speed and distance were sampled
+  uint64_t get_timestamp_us() const { return timestamp_us_; }
+
+protected:
+  WheelEncoder encoder_;
+  const float meters_per_pulse_;
+
+  // pulse count and time of the edge the counting window started at
+  int window_pulses_{0};
+  uint32_t window_start_us_{0};
+
+  float speed_{0.0f};
+  float distance_{0.0f};
+  uint64_t timestamp_us_{0};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // WHEEL_ODOMETRY_PROVIDER_HPP_
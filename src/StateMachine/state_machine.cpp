@@ -10,6 +10,7 @@
  */
 
 #include "state_machine.hpp"
+#include "Tools/crash_recorder.hpp"
 #include <iostream>
 /**
  * @brief GkcStateMachine constructor
@@ -140,7 +141,7 @@ StateTransitionResult GkcStateMachine::emergency_stop() {
     break;
   case StateTransitionResult::ERROR:
     // std::cout << "Resetting MCU for Estop Failure";
-    NVIC_SystemReset();
+    CrashRecorder::reset("E-stop failure");
   default:
     state_ = GkcLifecycle::Emergency;
     break;
@@ -181,6 +182,12 @@ GkcLifecycle GkcStateMachine::get_state() const { return state_; }
 
 void GkcStateMachine::common_checks()
 {
+  if(state_ != reported_state_){
+    const GkcLifecycle from = reported_state_;
+    reported_state_ = state_;
+    on_state_change(from, state_);
+  }
+
   if(state_ == GkcLifecycle::Active)
     _led = 0;
   else
@@ -57,10 +57,13 @@ protected:
   virtual StateTransitionResult on_activate(const GkcLifecycle &last_state) = 0;
   virtual StateTransitionResult on_emergency_stop(const GkcLifecycle &last_state) = 0;
   virtual StateTransitionResult on_reinitialize(const GkcLifecycle &last_state) = 0;
+  // Called after every transition that changed the state
+  virtual void on_state_change(const GkcLifecycle &from, const GkcLifecycle &to) {}
 
 // The current state of the state machine
 private:
   GkcLifecycle state_ {GkcLifecycle::Uninitialized};
+  GkcLifecycle reported_state_ {GkcLifecycle::Uninitialized};
   void common_checks();
   DigitalOut _led{LED3, 0};
 };
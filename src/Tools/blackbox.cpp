@@ -0,0 +1,242 @@
+/**
+ * @file blackbox.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "blackbox.hpp"
+#include "ThisThread.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tritonai {
+namespace gkc {
+using namespace blackbox;
+
+MBED_ALIGN(32) uint8_t BlackBox::blocks_[2][BLACKBOX_BLOCK_SIZE];
+
+BlackBox::BlackBox(BlockDevice *device) : device_(device) {
+  writer_thread_.start(callback(this, &BlackBox::writer_thread_impl));
+}
+
+void BlackBox::log_setpoint(float throttle, float steering, float brake) {
+  const SetpointRecord record{throttle, steering, brake};
+  append(RECORD_SETPOINT, &record, sizeof(record));
+}
+
+void BlackBox::log_state(GkcLifecycle from, GkcLifecycle to) {
+  const StateRecord record{static_cast<uint8_t>(from),
+                           static_cast<uint8_t>(to)};
+  append(RECORD_STATE, &record, sizeof(record));
+}
+
+void BlackBox::log_link(uint32_t packets_sent, uint32_t packets_dropped,
+                        uint32_t bytes_received) {
+  const LinkRecord record{packets_sent, packets_dropped, bytes_received,
+                          dropped_.load()};
+  append(RECORD_LINK, &record, sizeof(record));
+}
+
+void BlackBox::log_can(uint8_t port, const CanBusHealth &health) {
+  const CanRecord record{port,
+                         health.tx_fps,
+                         health.rx_fps,
+                         health.load_pct,
+                         health.tx_errors,
+                         health.rx_errors,
+                         health.error_passive,
+                         health.bus_off,
+                         health.last_recovery_us,
+                         health.tx_dropped,
+                         health.tx_retries,
+                         health.tx_suppressed};
+  append(RECORD_CAN, &record, sizeof(record));
+}
+
+void BlackBox::populate_reading(SensorGkcPacket &pkt) {
+  SensorRecord record;
+  record.wheel_speed_rl = pkt.wheel_speed_rl;
+  record.wheel_speed_rr = pkt.wheel_speed_rr;
+  record.wheel_distance = pkt.wheel_distance;
+  record.steering_angle_rad = pkt.steering_angle_rad;
+  record.brake_pressure = pkt.brake_pressure;
+  record.motor_erpm = pkt.motor_erpm;
+  record.motor_current = pkt.motor_current;
+  record.motor_duty_cycle = pkt.motor_duty_cycle;
+  record.supply_voltage = pkt.supply_voltage;
+  record.motor_tachometer = pkt.motor_tachometer;
+  record.imu_yaw_rate = pkt.imu_yaw_rate;
+  record.imu_accel_x = pkt.imu_accel_x;
+  record.imu_accel_y = pkt.imu_accel_y;
+  record.est_speed = pkt.est_speed;
+  record.est_yaw_rate = pkt.est_yaw_rate;
+  record.est_slip = pkt.est_slip;
+  append(RECORD_SENSOR, &record, sizeof(record));
+}
+
+void BlackBox::append(RecordType type, const void *payload, uint8_t length) {
+  if (!running_) {
+    // still mounting, the buffers are in use
+    return;
+  }
+  const RecordHeader header{type, length, now_us()};
+  const size_t size = sizeof(header) + length;
+
+  lock_.lock();
+  if (used_[active_] + size > BLACKBOX_BLOCK_SIZE) {
+    if (pending_ >= 0) {
+      // storage is a whole block behind, shed load instead of blocking
+      lock_.unlock();
+      ++dropped_;
+      return;
+    }
+    rotate();
+    writer_thread_.flags_set(BLOCK_FULL_FLAG);
+  }
+  uint8_t *dst = blocks_[active_] + used_[active_];
+  std::memcpy(dst, &header, sizeof(header));
+  std::memcpy(dst + sizeof(header), payload, length);
+  used_[active_] += size;
+  lock_.unlock();
+}
+
+void BlackBox::rotate() {
+  const BlockHeader header{BLOCK_MAGIC, sequence_++,
+                           static_cast<uint16_t>(used_[active_] -
+                                                 sizeof(BlockHeader)),
+                           FORMAT_VERSION};
+  std::memcpy(blocks_[active_], &header, sizeof(header));
+  // erased-looking tail, the header says where the records end
+  std::memset(blocks_[active_] + used_[active_], 0xFF,
+              BLACKBOX_BLOCK_SIZE - used_[active_]);
+  pending_ = active_;
+  active_ ^= 1;
+  used_[active_] = sizeof(BlockHeader);
+}
+
+void BlackBox::writer_thread_impl() {
+  if (!mount()) {
+    // no card or flash, the recorder stays off
+    return;
+  }
+  running_ = true;
+
+  while (true) {
+    ThisThread::flags_wait_any_for(BLOCK_FULL_FLAG,
+                                   std::chrono::milliseconds(BLACKBOX_FLUSH_MS));
+    lock_.lock();
+    if (pending_ < 0 && used_[active_] > sizeof(BlockHeader)) {
+      // quiet period, push out the partial block so a reset loses little
+      rotate();
+    }
+    const int pending = pending_;
+    lock_.unlock();
+
+    if (pending >= 0) {
+      write_block(pending);
+      lock_.lock();
+      pending_ = -1;
+      lock_.unlock();
+    }
+  }
+}
+
+bool BlackBox::mount() {
+  if (device_ == nullptr || device_->init() != 0) {
+    return false;
+  }
+  if (BLACKBOX_BLOCK_SIZE % device_->get_program_size() != 0) {
+    return false;
+  }
+  erase_size_ = device_->get_erase_size();
+  region_size_ = device_->size();
+  if (BLACKBOX_REGION_SIZE > 0) {
+    region_size_ = std::min<uint64_t>(region_size_, BLACKBOX_REGION_SIZE);
+  }
+  // whole erase units of whole blocks
+  const uint64_t unit = std::max<uint64_t>(erase_size_, BLACKBOX_BLOCK_SIZE);
+  region_size_ -= region_size_ % unit;
+  const uint64_t num_blocks = region_size_ / BLACKBOX_BLOCK_SIZE;
+  if (num_blocks < 2) {
+    return false;
+  }
+
+  // Sequence numbers increase along the ring from its oldest block up to
+  // the newest one, then drop (older or erased blocks). Binary search for
+  // the drop so a large card mounts after a handful of reads.
+  BlockHeader first;
+  if (!read_header(0, first)) {
+    address_ = 0;
+    sequence_ = 1;
+    return true;
+  }
+  uint64_t lo = 0, hi = num_blocks - 1;
+  while (lo < hi) {
+    const uint64_t mid = (lo + hi + 1) / 2;
+    BlockHeader header;
+    if (read_header(mid, header) && header.sequence >= first.sequence) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  BlockHeader newest;
+  read_header(lo, newest);
+  sequence_ = newest.sequence + 1;
+  address_ = ((lo + 1) % num_blocks) * BLACKBOX_BLOCK_SIZE;
+  return true;
+}
+
+bool BlackBox::read_header(uint64_t block, BlockHeader &header) {
+  // the writer is not running yet, borrow the second buffer
+  const uint64_t read_size = device_->get_read_size();
+  const uint64_t size =
+      (sizeof(BlockHeader) + read_size - 1) / read_size * read_size;
+  if (device_->read(blocks_[1], block * BLACKBOX_BLOCK_SIZE, size) != 0) {
+    return false;
+  }
+  std::memcpy(&header, blocks_[1], sizeof(header));
+  return header.magic == BLOCK_MAGIC;
+}
+
+bool BlackBox::write_block(int index) {
+  for (int attempt = 0; attempt <= BLACKBOX_WRITE_RETRIES; ++attempt) {
+    if (try_write_block(index)) {
+      address_ += BLACKBOX_BLOCK_SIZE;
+      if (address_ >= region_size_) {
+        address_ = 0;
+      }
+      return true;
+    }
+    if (attempt < BLACKBOX_WRITE_RETRIES) {
+      ThisThread::sleep_for(std::chrono::milliseconds(BLACKBOX_RETRY_MS));
+    }
+  }
+  // The slot keeps whatever it held and the next block is written there.
+  // Moving on would leave an old block in the middle of the ring, and the
+  // search on mount would end the log there. The lost block only leaves a
+  // gap in the sequence numbers.
+  ++blocks_lost_;
+  return false;
+}
+
+bool BlackBox::try_write_block(int index) {
+  if (address_ % erase_size_ == 0 &&
+      device_->erase(address_,
+                     std::max<uint64_t>(erase_size_, BLACKBOX_BLOCK_SIZE)) != 0) {
+    ++write_failures_;
+    return false;
+  }
+  if (device_->program(blocks_[index], address_, BLACKBOX_BLOCK_SIZE) != 0) {
+    ++write_failures_;
+    return false;
+  }
+  return true;
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,187 @@
+/**
+ * @file blackbox.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Black box recorder. Setpoints, sensor snapshots, state transitions and
+ * link statistics are appended as small fixed-layout records to one of two
+ * RAM blocks; a low priority thread writes full blocks to a block device
+ * (the SD card set up in config.hpp) while the other block fills. Callers
+ * never wait on storage: if the device falls a whole block behind, records
+ * are dropped and counted instead.
+ *
+ * The first BLACKBOX_REGION_SIZE bytes of the device are used raw, with no
+ * file system, as a ring of BLACKBOX_BLOCK_SIZE blocks. Every block
+ * starts with a BlockHeader carrying an increasing sequence number, which
+ * is how the end of the previous log is found after a reset and how the
+ * host decoder (blackbox_decode.py) puts blocks back in order. Keep that
+ * script in sync with the layouts below.
+ *
+ */
+#ifndef BLACKBOX_HPP_
+#define BLACKBOX_HPP_
+
+#include "Actuation/can_bus.hpp"
+#include "Mutex.h"
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+namespace blackbox {
+constexpr uint32_t BLOCK_MAGIC = 0x42424B47; // "GKBB"
+constexpr uint16_t FORMAT_VERSION = 1;
+
+enum RecordType : uint8_t {
+  RECORD_SETPOINT = 1,
+  RECORD_SENSOR = 2,
+  RECORD_STATE = 3,
+  RECORD_LINK = 4,
+  RECORD_CAN = 5,
+};
+
+// All layouts are packed little endian
+struct __attribute__((packed)) BlockHeader {
+  uint32_t magic;
+  uint32_t sequence;
+  uint16_t used; // bytes of records following the header
+  uint16_t version;
+};
+
+struct __attribute__((packed)) RecordHeader {
+  uint8_t type;
+  uint8_t length; // payload bytes
+  uint64_t timestamp_us;
+};
+
+struct __attribute__((packed)) SetpointRecord {
+  float throttle;
+  float steering;
+  float brake;
+};
+
+struct __attribute__((packed)) SensorRecord {
+  float wheel_speed_rl;
+  float wheel_speed_rr;
+  float wheel_distance;
+  float steering_angle_rad;
+  float brake_pressure;
+  float motor_erpm;
+  float motor_current;
+  float motor_duty_cycle;
+  float supply_voltage;
+  int32_t motor_tachometer;
+  float imu_yaw_rate;
+  float imu_accel_x;
+  float imu_accel_y;
+  float est_speed;
+  float est_yaw_rate;
+  float est_slip;
+};
+
+struct __attribute__((packed)) StateRecord {
+  uint8_t from;
+  uint8_t to;
+};
+
+struct __attribute__((packed)) LinkRecord {
+  uint32_t packets_sent;
+  uint32_t packets_dropped;
+  uint32_t bytes_received;
+  uint32_t records_dropped;
+};
+
+struct __attribute__((packed)) CanRecord {
+  uint8_t port;
+  float tx_fps;
+  float rx_fps;
+  float load_pct;
+  uint8_t tx_errors;
+  uint8_t rx_errors;
+  uint32_t error_passive;
+  uint32_t bus_off;
+  uint32_t last_recovery_us;
+  uint32_t tx_dropped;
+  uint32_t tx_retries;
+  uint32_t tx_suppressed;
+};
+
+static_assert(sizeof(BlockHeader) == 12, "layout shared with the decoder");
+static_assert(sizeof(RecordHeader) == 10, "layout shared with the decoder");
+static_assert(sizeof(SensorRecord) == 64, "layout shared with the decoder");
+} // namespace blackbox
+
+class BlackBox : public ISensorProvider {
+public:
+  explicit BlackBox(BlockDevice *device);
+
+  void log_setpoint(float throttle, float steering, float brake);
+  void log_state(GkcLifecycle from, GkcLifecycle to);
+  void log_link(uint32_t packets_sent, uint32_t packets_dropped,
+                uint32_t bytes_received);
+  void log_can(uint8_t port, const CanBusHealth &health);
+  // records lost because storage could not keep up
+  uint32_t get_dropped() const { return dropped_.load(); }
+  // erase or program calls that failed, and blocks lost after all retries
+  uint32_t get_write_failures() const { return write_failures_.load(); }
+  uint32_t get_blocks_lost() const { return blocks_lost_.load(); }
+
+  // ISensorProvider API, samples the sensor packet at its own rate once the
+  // sensors of the cycle have filled it
+  bool is_ready() override { return running_.load(); }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(BLACKBOX_SENSOR_INTERVAL_MS);
+  }
+  bool is_recorder() const override { return true; }
+
+protected:
+  static constexpr uint32_t BLOCK_FULL_FLAG = 1;
+
+  BlockDevice *device_;
+  uint64_t region_size_{0};
+  uint64_t erase_size_{0};
+  uint64_t address_{0};
+  uint32_t sequence_{1};
+
+  // blocks_[active_] is being filled, blocks_[pending_] waits for storage.
+  // Static so the cache line alignment holds for a heap allocated owner.
+  static uint8_t blocks_[2][BLACKBOX_BLOCK_SIZE];
+  size_t used_[2]{sizeof(blackbox::BlockHeader),
+                  sizeof(blackbox::BlockHeader)};
+  int active_{0};
+  int pending_{-1};
+  Mutex lock_;
+
+  std::atomic<bool> running_{false};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> write_failures_{0};
+  std::atomic<uint32_t> blocks_lost_{0};
+
+  Thread writer_thread_{osPriorityLow, OS_STACK_SIZE, nullptr,
+                        "blackbox_thread"};
+  void writer_thread_impl();
+  // finds the end of the previous log, false if the device is unusable
+  bool mount();
+  bool read_header(uint64_t block, blackbox::BlockHeader &header);
+  // writes a block at address_ and moves past it, false if it was lost
+  bool write_block(int index);
+  bool try_write_block(int index);
+  // seals the active block and queues it, call with lock_ held
+  void rotate();
+  void append(blackbox::RecordType type, const void *payload, uint8_t length);
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // BLACKBOX_HPP_
@@ -0,0 +1,231 @@
+/**
+ * @file crash_recorder.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ */
+
+#include "crash_recorder.hpp"
+#include "Comm/comm.hpp"
+#include "ThisThread.h"
+#include <cstdio>
+#include <cstring>
+
+namespace tritonai {
+namespace gkc {
+namespace {
+const char *lifecycle_name(uint32_t state) {
+  static const char *const names[] = {"Uninitialized", "Initializing",
+                                      "Inactive", "Active", "Emergency"};
+  return state < sizeof(names) / sizeof(names[0]) ? names[state] : "Unknown";
+}
+
+std::string milli(float value) {
+  return std::to_string(static_cast<int>(value * 1000.0f));
+}
+} // namespace
+
+CrashRecorder *CrashRecorder::instance_ = nullptr;
+
+CrashRecorder::CrashRecorder() {
+  // Keep the newest frozen slot for the dump and record into the other one
+  uint32_t sequence = 0;
+  for (size_t i = 0; i < 2; ++i) {
+    Slot *slot = slot_at(i);
+    if (slot->header.magic != SLOT_MAGIC) {
+      continue;
+    }
+    if (slot->header.sequence > sequence) {
+      sequence = slot->header.sequence;
+    }
+    if (valid(*slot) &&
+        (crash_ == nullptr ||
+         slot->header.sequence > crash_->header.sequence)) {
+      crash_ = slot;
+    }
+  }
+  recording_ = crash_ == slot_at(0) ? slot_at(1) : slot_at(0);
+  std::memset(recording_, 0, sizeof(Slot));
+  recording_->header.magic = SLOT_MAGIC;
+  recording_->header.sequence = sequence + 1;
+
+  instance_ = this;
+  mbed_set_error_hook(&CrashRecorder::on_mbed_error);
+  dump_thread_.start(callback(this, &CrashRecorder::dump_thread_impl));
+}
+
+void CrashRecorder::record_command(float throttle, float steering,
+                                   float brake) {
+  uint32_t values[3];
+  const float f[3] = {throttle, steering, brake};
+  std::memcpy(values, f, sizeof(values));
+  append(ENTRY_COMMAND, values);
+}
+
+void CrashRecorder::record_state(GkcLifecycle from, GkcLifecycle to) {
+  const uint32_t values[3] = {static_cast<uint32_t>(from),
+                              static_cast<uint32_t>(to), 0};
+  append(ENTRY_STATE, values);
+}
+
+void CrashRecorder::record_thread_stats() {
+#if defined(MBED_THREAD_STATS_ENABLED) && MBED_THREAD_STATS_ENABLED
+  mbed_stats_thread_t stats[MAX_THREADS];
+  const size_t count = mbed_stats_thread_get_each(stats, MAX_THREADS);
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t values[3] = {0, stats[i].stack_size, stats[i].stack_space};
+    if (stats[i].name != nullptr) {
+      std::strncpy(reinterpret_cast<char *>(&values[0]), stats[i].name,
+                   sizeof(values[0]));
+    }
+    append(ENTRY_THREAD, values);
+  }
+#endif
+}
+
+void CrashRecorder::populate_reading(SensorGkcPacket &pkt) {
+  uint32_t values[3];
+  const float f[3] = {pkt.est_speed, pkt.steering_angle_rad,
+                      pkt.motor_current};
+  std::memcpy(values, f, sizeof(values));
+  append(ENTRY_SENSOR, values);
+}
+
+void CrashRecorder::append(uint32_t type, const uint32_t values[3]) {
+  // Entries come from several threads; the section is a few stores long
+  core_util_critical_section_enter();
+  SlotHeader &header = recording_->header;
+  if (!header.frozen) {
+    Entry &entry = recording_->entries[header.head];
+    entry.timestamp_us = now_us();
+    entry.type = type;
+    std::memcpy(entry.values.u, values, sizeof(entry.values.u));
+    header.head = (header.head + 1) % NUM_ENTRIES;
+    if (header.count < NUM_ENTRIES) {
+      ++header.count;
+    }
+  }
+  core_util_critical_section_exit();
+}
+
+void CrashRecorder::freeze(const char *reason) {
+  if (instance_ == nullptr) {
+    return;
+  }
+  core_util_critical_section_enter();
+  Slot &slot = *instance_->recording_;
+  if (!slot.header.frozen) {
+    slot.header.frozen = 1;
+    slot.header.frozen_at_us = now_us();
+    std::strncpy(slot.header.reason, reason, REASON_LENGTH - 1);
+    slot.header.reason[REASON_LENGTH - 1] = '\0';
+    slot.header.checksum = checksum(slot);
+  }
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  // a reset drops dirty cache lines, push the ring out to the RAM
+  SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t *>(&slot), sizeof(Slot));
+#endif
+  core_util_critical_section_exit();
+}
+
+void CrashRecorder::reset(const char *reason) {
+  freeze(reason);
+  NVIC_SystemReset();
+}
+
+void CrashRecorder::on_mbed_error(const mbed_error_ctx *ctx) {
+  // Runs for fatal errors, HardFaults included, right before mbed halts or
+  // reboots. Warnings come through here too; they are rare enough that
+  // keeping the context around them is worth the stopped recording.
+  char reason[REASON_LENGTH];
+  snprintf(reason, sizeof(reason), "mbed error 0x%08lx",
+           static_cast<unsigned long>(ctx->error_status));
+  freeze(reason);
+}
+
+bool CrashRecorder::valid(const Slot &slot) {
+  return slot.header.magic == SLOT_MAGIC && slot.header.frozen == 1 &&
+         slot.header.head < NUM_ENTRIES && slot.header.count <= NUM_ENTRIES &&
+         slot.header.checksum == checksum(slot);
+}
+
+uint32_t CrashRecorder::checksum(const Slot &slot) {
+  // FNV-1a over everything after the checksum field
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&slot);
+  uint32_t hash = 2166136261u;
+  for (size_t i = offsetof(SlotHeader, frozen); i < sizeof(Slot); ++i) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+void CrashRecorder::dump(CommManager *comm) {
+  comm_ = comm;
+  if (crash_ != nullptr) {
+    dump_thread_.flags_set(DUMP_FLAG);
+  }
+}
+
+void CrashRecorder::dump_thread_impl() {
+  const auto pacing = std::chrono::milliseconds(CRASH_RECORDER_DUMP_INTERVAL_MS);
+  while (true) {
+    ThisThread::flags_wait_any(DUMP_FLAG);
+    if (crash_ == nullptr || comm_ == nullptr) {
+      continue;
+    }
+    const SlotHeader &header = crash_->header;
+    LogPacket packet;
+    packet.level = LogPacket::Severity::WARNING;
+    packet.what = "Crash recorder: last run ended by " +
+                  std::string(header.reason) + ", " +
+                  std::to_string(header.count) + " entries follow";
+    comm_->send(packet);
+    ThisThread::sleep_for(pacing);
+
+    // oldest first, the send queue is small so pace the packets
+    const uint32_t first =
+        (header.head + NUM_ENTRIES - header.count) % NUM_ENTRIES;
+    for (uint32_t i = 0; i < header.count; ++i) {
+      packet.what = describe(crash_->entries[(first + i) % NUM_ENTRIES]);
+      comm_->send(packet);
+      ThisThread::sleep_for(pacing);
+    }
+
+    // dumped, let the slot be reused
+    crash_->header.magic = 0;
+    crash_ = nullptr;
+  }
+}
+
+std::string CrashRecorder::describe(const Entry &entry) const {
+  const uint64_t before_us = crash_->header.frozen_at_us - entry.timestamp_us;
+  std::string what = "Crash t-" + std::to_string(before_us / 1000) + "ms ";
+  switch (entry.type) {
+  case ENTRY_COMMAND:
+    return what + "command x1000 throttle " + milli(entry.values.f[0]) +
+           " steering " + milli(entry.values.f[1]) + " brake " +
+           milli(entry.values.f[2]);
+  case ENTRY_SENSOR:
+    return what + "sensor x1000 speed " + milli(entry.values.f[0]) +
+           " steering " + milli(entry.values.f[1]) + " current " +
+           milli(entry.values.f[2]);
+  case ENTRY_STATE:
+    return what + "state " + lifecycle_name(entry.values.u[0]) + " -> " +
+           lifecycle_name(entry.values.u[1]);
+  case ENTRY_THREAD: {
+    const char *name = reinterpret_cast<const char *>(&entry.values.u[0]);
+    return what + "thread " +
+           std::string(name, strnlen(name, sizeof(entry.values.u[0]))) +
+           " stack " + std::to_string(entry.values.u[2]) + " of " +
+           std::to_string(entry.values.u[1]) + " bytes free";
+  }
+  default:
+    return what + "unknown entry";
+  }
+}
+
+} // namespace gkc
+} // namespace tritonai
@@ -0,0 +1,124 @@
+/**
+ * @file crash_recorder.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Keeps the last seconds of commands, sensor snapshots, state transitions
+ * and thread stack usage in a ring in RAM that survives a reset. The ring
+ * is frozen when a watchdog resets the MCU or mbed reports an error (which
+ * includes HardFaults), and dumped as log packets after the next handshake.
+ *
+ * The RAM at CRASH_RECORDER_ADDRESS holds two slots, so a new run records
+ * into one while the frozen one waits to be dumped.
+ *
+ */
+#ifndef CRASH_RECORDER_HPP_
+#define CRASH_RECORDER_HPP_
+
+#include "Sensor/sensor_reader.hpp"
+#include "Tools/timebase.hpp"
+#include "config.hpp"
+#include "mbed.h"
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tritonai {
+namespace gkc {
+class CommManager;
+
+class CrashRecorder : public ISensorProvider {
+public:
+  CrashRecorder();
+
+  void record_command(float throttle, float steering, float brake);
+  void record_state(GkcLifecycle from, GkcLifecycle to);
+  // stack usage of every thread, platform.thread-stats-enabled in mbed_app.json
+  void record_thread_stats();
+
+  // true if the previous run left a frozen ring behind
+  bool has_crash() const { return crash_ != nullptr; }
+  // sends the frozen ring over the comm link from a background thread
+  void dump(CommManager *comm);
+
+  // Freezes the ring so it survives the reset, safe from fault handlers
+  static void freeze(const char *reason);
+  // freeze() then NVIC_SystemReset(), for watchdogs and fatal errors
+  static void reset(const char *reason);
+
+  // ISensorProvider API, samples the sensor packet at its own rate
+  bool is_ready() override { return true; }
+  void populate_reading(SensorGkcPacket &pkt) override;
+  std::chrono::milliseconds get_poll_interval() const override {
+    return std::chrono::milliseconds(CRASH_RECORDER_SENSOR_INTERVAL_MS);
+  }
+  bool is_recorder() const override { return true; }
+
+protected:
+  enum EntryType : uint32_t {
+    ENTRY_COMMAND = 1, // throttle, steering, brake
+    ENTRY_SENSOR = 2,  // speed, steering angle, motor current
+    ENTRY_STATE = 3,   // from, to
+    ENTRY_THREAD = 4,  // name (4 chars), stack size, free stack
+  };
+
+  struct Entry {
+    uint64_t timestamp_us;
+    uint32_t type;
+    union {
+      float f[3];
+      uint32_t u[3];
+    } values;
+  };
+
+  static constexpr uint32_t DUMP_FLAG = 1;
+  static constexpr size_t MAX_THREADS = 24;
+  static constexpr uint32_t SLOT_MAGIC = 0x43524153; // "CRAS"
+  static constexpr size_t REASON_LENGTH = 32;
+  struct SlotHeader {
+    uint32_t magic;
+    uint32_t checksum; // over everything after this field, set on freeze
+    uint32_t frozen;
+    uint32_t sequence; // orders slots across resets
+    uint32_t head;     // next entry to write
+    uint32_t count;
+    uint64_t frozen_at_us;
+    char reason[REASON_LENGTH];
+  };
+  static constexpr size_t NUM_ENTRIES =
+      (CRASH_RECORDER_SLOT_SIZE - sizeof(SlotHeader)) / sizeof(Entry);
+  struct Slot {
+    SlotHeader header;
+    Entry entries[NUM_ENTRIES];
+  };
+  static_assert(sizeof(Slot) <= CRASH_RECORDER_SLOT_SIZE,
+                "slot does not fit CRASH_RECORDER_SLOT_SIZE");
+
+  static CrashRecorder *instance_;
+  static Slot *slot_at(size_t index) {
+    return reinterpret_cast<Slot *>(CRASH_RECORDER_ADDRESS +
+                                    index * CRASH_RECORDER_SLOT_SIZE);
+  }
+  Slot *recording_;
+  Slot *crash_{nullptr};
+  CommManager *comm_{nullptr};
+
+  Thread dump_thread_{osPriorityLow, OS_STACK_SIZE, nullptr,
+                      "crash_dump_thread"};
+  void dump_thread_impl();
+
+  void append(uint32_t type, const uint32_t values[3]);
+  static bool valid(const Slot &slot);
+  static uint32_t checksum(const Slot &slot);
+  static void on_mbed_error(const mbed_error_ctx *ctx);
+  std::string describe(const Entry &entry) const;
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // CRASH_RECORDER_HPP_
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <mbed.h>
 #include <sstream>
+#include "timebase.hpp"
 #include <string>
 #include <vector>
 #define AVERAGE_WINDOW_SIZE 10
@@ -38,8 +39,7 @@ public:
  */
   void start_timer() {
     if (!profiling_) {
-      timer_.reset();
-      timer_.start();
+      start_us_ = now_us();
       profiling_ = true;
     }
   }
@@ -48,12 +48,12 @@ public:
  * 
  */
   void stop_timer() {
-    timer_.stop();
+    const std::chrono::microseconds elapsed(now_us() - start_us_);
     profiling_ = false;
     if (buffer_.size() == AVERAGE_WINDOW_SIZE) {
       buffer_.erase(buffer_.begin());
     }
-    buffer_.push_back(timer_.elapsed_time());
+    buffer_.push_back(elapsed);
   }
 /**
  * @brief Getter for the last time on the buffer
@@ -97,12 +97,12 @@ public:
   }
 /**
  * @brief Protected variables and functions for the profiler
- * timer is the timer object
+ * start_us is the now_us() time the timer was started
  * buffer is the buffer of times
  * name is the name of the profiler
  */
 protected:
-  Timer timer_;
+  uint64_t start_us_{0};
   std::vector<std::chrono::microseconds> buffer_;
   std::string name_;
   bool profiling_{false};
@@ -0,0 +1,86 @@
+/**
+ * @file small_matrix.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Fixed-size matrices in static storage, with plain loops for the
+ * operations. mbed-os does not ship CMSIS-DSP, and at the sizes of the
+ * state estimator its kernels would not pay for the call overhead anyway.
+ * The same filter code builds for the MCU and for a host.
+ *
+ */
+#ifndef SMALL_MATRIX_HPP_
+#define SMALL_MATRIX_HPP_
+
+#include <cstddef>
+
+namespace tritonai {
+namespace gkc {
+// Row-major R x C matrix of floats
+template <size_t R, size_t C> struct Matrix {
+  float data[R * C]{};
+
+  float &operator()(size_t row, size_t col) { return data[row * C + col]; }
+  const float &operator()(size_t row, size_t col) const {
+    return data[row * C + col];
+  }
+
+  static Matrix identity() {
+    static_assert(R == C, "identity of a non-square matrix");
+    Matrix m;
+    for (size_t i = 0; i < R; ++i) {
+      m(i, i) = 1.0f;
+    }
+    return m;
+  }
+};
+
+// out = a * b
+template <size_t R, size_t K, size_t C>
+void mat_mult(const Matrix<R, K> &a, const Matrix<K, C> &b,
+              Matrix<R, C> &out) {
+  for (size_t r = 0; r < R; ++r) {
+    for (size_t c = 0; c < C; ++c) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < K; ++k) {
+        sum += a(r, k) * b(k, c);
+      }
+      out(r, c) = sum;
+    }
+  }
+}
+
+// out = a + b
+template <size_t R, size_t C>
+void mat_add(const Matrix<R, C> &a, const Matrix<R, C> &b,
+             Matrix<R, C> &out) {
+  for (size_t i = 0; i < R * C; ++i) {
+    out.data[i] = a.data[i] + b.data[i];
+  }
+}
+
+// out = a - b
+template <size_t R, size_t C>
+void mat_sub(const Matrix<R, C> &a, const Matrix<R, C> &b,
+             Matrix<R, C> &out) {
+  for (size_t i = 0; i < R * C; ++i) {
+    out.data[i] = a.data[i] - b.data[i];
+  }
+}
+
+// out = a^T
+template <size_t R, size_t C>
+void mat_trans(const Matrix<R, C> &a, Matrix<C, R> &out) {
+  for (size_t r = 0; r < R; ++r) {
+    for (size_t c = 0; c < C; ++c) {
+      out(c, r) = a(r, c);
+    }
+  }
+}
+} // namespace gkc
+} // namespace tritonai
+
+#endif // SMALL_MATRIX_HPP_
@@ -0,0 +1,53 @@
+/**
+ * @file timebase.hpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * The one clock for stamping data. Samples, frames and packets are stamped
+ * with now_us() when they arrive, so latencies and sample spacing can be
+ * compared across the whole firmware.
+ *
+ */
+#ifndef TIMEBASE_HPP_
+#define TIMEBASE_HPP_
+
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_atomic.h"
+#include <cstdint>
+
+namespace tritonai {
+namespace gkc {
+/**
+ * @brief Microseconds since boot, monotonic and free-running
+ * Reads the 32-bit 1 MHz us_ticker timer, extended to 64 bits by the mbed
+ * ticker layer, so it never wraps in practice. Safe to call from interrupts
+ * and any thread.
+ *
+ * @note Not the same origin as the raw us_ticker_read() counter, only
+ * compare values from this function with each other.
+ * @return uint64_t
+ */
+inline uint64_t now_us() { return ticker_read_us(get_us_ticker_data()); }
+
+/**
+ * @brief A now_us() stamp written on one thread and read on another
+ * 64-bit loads and stores are two accesses on the Cortex-M7, so a plain
+ * member can be read half updated, and std::atomic<uint64_t> needs library
+ * calls the toolchain does not provide. Safe in interrupts.
+ */
+class TimeStamp {
+public:
+  uint64_t load() const { return core_util_atomic_load_u64(&value_); }
+  void store(uint64_t us) { core_util_atomic_store_u64(&value_, us); }
+
+protected:
+  volatile uint64_t value_{0};
+};
+} // namespace gkc
+} // namespace tritonai
+
+#endif // TIMEBASE_HPP_
@@ -1,4 +1,5 @@
 #include "watchdog.hpp"
+#include "Tools/crash_recorder.hpp"
 
 #include <chrono>
 #include <functional>
@@ -43,7 +44,7 @@ void Watchdog::disarm() {
 void Watchdog::watchdog_callback() {//would be called when the watchdog timer expires 
   std::cout << "Watchdog timeout" << std::endl;
   // Restart the system 
-  NVIC_SystemReset();
+  CrashRecorder::reset("Watchdog watchdog");
 }
 //start a thread that continuously monitors the watchlist nd checks for any activity.
 void Watchdog::start_watch_thread() {
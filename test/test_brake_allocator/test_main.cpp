@@ -0,0 +1,118 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * BrakeAllocator on the host: the split of a brake demand between regen and
+ * the actuator, and the speed and battery fade of regen.
+ *
+ */
+#include "Actuation/brake_allocator.hpp"
+#include <unity.h>
+
+using tritonai::gkc::BrakeAllocation;
+using tritonai::gkc::BrakeAllocator;
+
+namespace {
+constexpr float EPS = 1e-5f;
+constexpr float FAST = REGEN_FULL_SPEED_MS + 2.0f;
+constexpr float LOW_BATTERY = BATTERY_REGEN_TAPER_V - 2.0f;
+
+// brake command the allocation is worth
+float braking(const BrakeAllocation &a) {
+  return a.mechanical + a.regen * REGEN_BRAKE_EQUIVALENT;
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_no_regen_below_min_speed() {
+  const BrakeAllocation a = BrakeAllocator::allocate(
+      0.2f, REGEN_MIN_SPEED_MS * 0.5f, true, LOW_BATTERY, true);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, a.regen);
+  TEST_ASSERT_EQUAL_FLOAT(0.2f, a.mechanical);
+}
+
+void test_no_regen_on_invalid_inputs() {
+  BrakeAllocation a =
+      BrakeAllocator::allocate(0.2f, FAST, false, LOW_BATTERY, true);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, a.regen);
+  TEST_ASSERT_EQUAL_FLOAT(0.2f, a.mechanical);
+  a = BrakeAllocator::allocate(0.2f, FAST, true, LOW_BATTERY, false);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, a.regen);
+  TEST_ASSERT_EQUAL_FLOAT(0.2f, a.mechanical);
+}
+
+void test_light_demand_is_all_regen() {
+  const float demand = REGEN_BRAKE_EQUIVALENT * 0.5f;
+  const BrakeAllocation a =
+      BrakeAllocator::allocate(demand, FAST, true, LOW_BATTERY, true);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.0f, a.mechanical);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.5f, a.regen);
+}
+
+void test_actuator_covers_the_rest() {
+  const float demand = REGEN_BRAKE_EQUIVALENT + 0.2f;
+  const BrakeAllocation a =
+      BrakeAllocator::allocate(demand, FAST, true, LOW_BATTERY, true);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 1.0f, a.regen);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.2f, a.mechanical);
+}
+
+void test_full_demand_uses_both() {
+  const BrakeAllocation a =
+      BrakeAllocator::allocate(1.0f, FAST, true, LOW_BATTERY, true);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, a.mechanical);
+  TEST_ASSERT_EQUAL_FLOAT(BrakeAllocator::regen_capacity(FAST, LOW_BATTERY),
+                          a.regen);
+}
+
+void test_split_adds_up_to_demand() {
+  const float speeds[] = {0.0f, REGEN_MIN_SPEED_MS,
+                          (REGEN_MIN_SPEED_MS + REGEN_FULL_SPEED_MS) / 2.0f,
+                          FAST};
+  for (float speed : speeds) {
+    for (int i = 0; i < 10; ++i) {
+      const float demand = i / 10.0f;
+      const BrakeAllocation a =
+          BrakeAllocator::allocate(demand, speed, true, LOW_BATTERY, true);
+      TEST_ASSERT_FLOAT_WITHIN(EPS, demand, braking(a));
+      TEST_ASSERT_TRUE(a.mechanical >= 0.0f);
+      TEST_ASSERT_TRUE(a.regen >= 0.0f && a.regen <= 1.0f);
+    }
+  }
+}
+
+void test_regen_fades_with_speed() {
+  const float mid = (REGEN_MIN_SPEED_MS + REGEN_FULL_SPEED_MS) / 2.0f;
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.5f,
+                           BrakeAllocator::regen_capacity(mid, LOW_BATTERY));
+  // in reverse as well
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.5f,
+                           BrakeAllocator::regen_capacity(-mid, LOW_BATTERY));
+}
+
+void test_regen_tapers_with_full_battery() {
+  const float mid = (BATTERY_REGEN_TAPER_V + BATTERY_REGEN_CUTOFF_V) / 2.0f;
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 0.5f,
+                           BrakeAllocator::regen_capacity(FAST, mid));
+  TEST_ASSERT_EQUAL_FLOAT(
+      0.0f, BrakeAllocator::regen_capacity(FAST, BATTERY_REGEN_CUTOFF_V));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_regen_below_min_speed);
+  RUN_TEST(test_no_regen_on_invalid_inputs);
+  RUN_TEST(test_light_demand_is_all_regen);
+  RUN_TEST(test_actuator_covers_the_rest);
+  RUN_TEST(test_full_demand_uses_both);
+  RUN_TEST(test_split_adds_up_to_demand);
+  RUN_TEST(test_regen_fades_with_speed);
+  RUN_TEST(test_regen_tapers_with_full_battery);
+  return UNITY_END();
+}
@@ -0,0 +1,63 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Interpolation of the brake pressure table on the host, against the rows
+ * of BRAKE_PRESSURE_MAPPING.
+ *
+ */
+#include "Actuation/brake_map.hpp"
+#include <unity.h>
+
+using namespace tritonai::gkc;
+
+namespace {
+constexpr float EPS = 1e-5f;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_pressure_at_rows_and_ends() {
+  for (size_t i = 0; i < brake_map::NUM_POINTS; ++i) {
+    const brake_map::Point &p = brake_map::POINTS[i];
+    TEST_ASSERT_FLOAT_WITHIN(EPS, p.pressure,
+                             brake_position_to_pressure(p.position));
+  }
+  TEST_ASSERT_EQUAL_FLOAT(brake_map::POINTS[0].pressure,
+                          brake_position_to_pressure(0.0f));
+  TEST_ASSERT_EQUAL_FLOAT(brake_map::MAX_PRESSURE,
+                          brake_position_to_pressure(MAX_BRAKE_VAL * 2.0f));
+}
+
+void test_command_range() {
+  TEST_ASSERT_EQUAL_FLOAT(brake_map::POINTS[0].position,
+                          brake_cmd_to_position(0.0f));
+  TEST_ASSERT_EQUAL_FLOAT(
+      brake_map::POINTS[brake_map::NUM_POINTS - 1].position,
+      brake_cmd_to_position(1.0f));
+  // out of range commands are held at the ends
+  TEST_ASSERT_EQUAL_FLOAT(brake_cmd_to_position(1.0f),
+                          brake_cmd_to_position(1.5f));
+}
+
+void test_round_trip() {
+  for (int i = 0; i <= 20; ++i) {
+    const float cmd = i / 20.0f;
+    const float pressure =
+        brake_position_to_pressure(brake_cmd_to_position(cmd));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, cmd * brake_map::MAX_PRESSURE, pressure);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_pressure_at_rows_and_ends);
+  RUN_TEST(test_command_range);
+  RUN_TEST(test_round_trip);
+  return UNITY_END();
+}
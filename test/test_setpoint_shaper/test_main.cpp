@@ -0,0 +1,113 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * SetpointShaper on the host: rate, acceleration and return limits, and
+ * arrival without overshoot.
+ *
+ */
+#include "Actuation/setpoint_shaper.hpp"
+#include <cmath>
+#include <unity.h>
+
+using tritonai::gkc::SetpointShaper;
+
+namespace {
+constexpr float DT = 0.001f;
+constexpr float COARSE_DT = 0.01f;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_disabled_limits_pass_through() {
+  SetpointShaper shaper(0.0f, 0.0f);
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, shaper.update(3.0f, DT));
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, shaper.update(-1.0f, DT));
+}
+
+void test_rate_limit() {
+  SetpointShaper shaper(2.0f, 0.0f);
+  for (int i = 0; i < 500; ++i) {
+    shaper.update(10.0f, DT);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.0f, shaper.get_value());
+}
+
+void test_acceleration_limit() {
+  const float max_accel = 4.0f;
+  SetpointShaper shaper(100.0f, max_accel);
+  float last_value = 0.0f;
+  float last_rate = 0.0f;
+  // up to the step that lands on the target
+  for (int i = 0; i < 5000; ++i) {
+    const float value = shaper.update(10.0f, COARSE_DT);
+    if (value >= 10.0f) {
+      break;
+    }
+    // a coarse step keeps float rounding of the difference small
+    const float rate = (value - last_value) / COARSE_DT;
+    TEST_ASSERT_TRUE(std::fabs(rate - last_rate) <=
+                     max_accel * COARSE_DT + 1e-3f);
+    last_value = value;
+    last_rate = rate;
+  }
+}
+
+void test_arrives_without_overshoot() {
+  SetpointShaper shaper(2.0f, 4.0f);
+  float peak = 0.0f;
+  for (int i = 0; i < 5000; ++i) {
+    peak = std::fmax(peak, shaper.update(1.0f, DT));
+  }
+  TEST_ASSERT_TRUE(peak <= 1.0f);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, shaper.get_value());
+
+  // and on the way back
+  float low = 1.0f;
+  for (int i = 0; i < 5000; ++i) {
+    low = std::fmin(low, shaper.update(-1.0f, DT));
+  }
+  TEST_ASSERT_TRUE(low >= -1.0f);
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, shaper.get_value());
+}
+
+void test_return_rate_towards_zero() {
+  SetpointShaper shaper(4.0f, 0.0f, 8.0f);
+  shaper.reset(10.0f);
+  for (int i = 0; i < 500; ++i) {
+    shaper.update(0.0f, DT);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 6.0f, shaper.get_value());
+
+  // away from zero, in reverse too, the plain rate applies
+  shaper.reset(0.0f);
+  for (int i = 0; i < 500; ++i) {
+    shaper.update(-10.0f, DT);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, -2.0f, shaper.get_value());
+}
+
+void test_return_rate_defaults_to_rate() {
+  SetpointShaper shaper(4.0f, 0.0f);
+  shaper.reset(10.0f);
+  for (int i = 0; i < 500; ++i) {
+    shaper.update(0.0f, DT);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.0f, shaper.get_value());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_disabled_limits_pass_through);
+  RUN_TEST(test_rate_limit);
+  RUN_TEST(test_acceleration_limit);
+  RUN_TEST(test_arrives_without_overshoot);
+  RUN_TEST(test_return_rate_towards_zero);
+  RUN_TEST(test_return_rate_defaults_to_rate);
+  return UNITY_END();
+}
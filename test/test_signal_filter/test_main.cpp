@@ -0,0 +1,152 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Signal filter stages on the host: spike rejection of the median, the
+ * notch and low-pass responses, priming, and the cost per sample of the
+ * plain C++ path that the MCU runs.
+ *
+ */
+#include "Sensor/signal_filter.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <unity.h>
+
+using namespace tritonai::gkc;
+
+namespace {
+constexpr float SAMPLE_HZ = 1000.0f;
+constexpr float PI = 3.14159265358979f;
+
+// peak output for a unit sine at hz, once the transient has died out
+template <typename Filter> float gain_at(Filter filter, float hz) {
+  float peak = 0.0f;
+  for (int i = 0; i < 4000; ++i) {
+    const float y = filter.process(std::sin(2.0f * PI * hz * i / SAMPLE_HZ));
+    if (i >= 3000) {
+      peak = std::fmax(peak, std::fabs(y));
+    }
+  }
+  return peak;
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_median_rejects_spike() {
+  MovingMedian median(5);
+  median.prime(1.0f);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, median.process(100.0f));
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, median.process(1.0f));
+  // but follows a step once it fills half the window
+  median.process(2.0f);
+  median.process(2.0f);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, median.process(2.0f));
+}
+
+void test_median_window_of_one_passes_through() {
+  MovingMedian median(1);
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, median.process(3.0f));
+  TEST_ASSERT_EQUAL_FLOAT(-7.0f, median.process(-7.0f));
+}
+
+void test_lowpass_response() {
+  const float cutoff = 50.0f;
+  const Biquad lowpass = Biquad::lowpass(SAMPLE_HZ, cutoff);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, gain_at(lowpass, cutoff / 10.0f));
+  // -3 dB at the cutoff for a Butterworth
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.7071f, gain_at(lowpass, cutoff));
+  TEST_ASSERT_TRUE(gain_at(lowpass, 400.0f) < 0.02f);
+}
+
+void test_notch_response() {
+  const float center = 100.0f;
+  const Biquad notch = Biquad::notch(SAMPLE_HZ, center, 2.0f);
+  TEST_ASSERT_TRUE(gain_at(notch, center) < 0.01f);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, gain_at(notch, 10.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, gain_at(notch, 400.0f));
+}
+
+void test_biquads_have_unity_dc_gain() {
+  Biquad lowpass = Biquad::lowpass(SAMPLE_HZ, 20.0f);
+  Biquad notch = Biquad::notch(SAMPLE_HZ, 100.0f, 2.0f);
+  lowpass.prime(2.5f);
+  notch.prime(2.5f);
+  for (int i = 0; i < 10; ++i) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.5f, lowpass.process(2.5f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.5f, notch.process(2.5f));
+  }
+}
+
+void test_chain_starts_from_first_reading() {
+  FilterSpec spec;
+  spec.median_window = 5;
+  spec.notch_hz = 100.0f;
+  spec.lowpass_hz = 20.0f;
+  SignalFilter filter(spec, SAMPLE_HZ);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 4.0f, filter.process(4.0f));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 4.0f, filter.process(4.0f));
+}
+
+void test_stages_above_nyquist_are_left_out() {
+  FilterSpec spec;
+  spec.lowpass_hz = SAMPLE_HZ;
+  SignalFilter filter(spec, SAMPLE_HZ);
+  filter.process(0.0f);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, filter.process(1.0f));
+}
+
+// Not a pass/fail test: the cost per sample of each stage, to compare with
+// a vectorized kernel should one ever be available for the target
+void test_benchmark() {
+  constexpr int SAMPLES = 1000000;
+  FilterSpec spec;
+  spec.median_window = MovingMedian::MAX_WINDOW;
+  spec.notch_hz = 100.0f;
+  spec.lowpass_hz = 20.0f;
+  SignalFilter chain(spec, SAMPLE_HZ);
+  Biquad lowpass = Biquad::lowpass(SAMPLE_HZ, 20.0f);
+  MovingMedian median(MovingMedian::MAX_WINDOW);
+
+  float sink = 0.0f;
+  auto time_ns = [&](auto &&stage) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SAMPLES; ++i) {
+      sink += stage(static_cast<float>(i % 17));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           SAMPLES;
+  };
+  char line[96];
+  std::snprintf(line, sizeof(line), "biquad: %.1f ns/sample",
+                time_ns([&](float x) { return lowpass.process(x); }));
+  TEST_MESSAGE(line);
+  std::snprintf(line, sizeof(line), "median of %u: %.1f ns/sample",
+                static_cast<unsigned>(MovingMedian::MAX_WINDOW),
+                time_ns([&](float x) { return median.process(x); }));
+  TEST_MESSAGE(line);
+  std::snprintf(line, sizeof(line), "full chain: %.1f ns/sample",
+                time_ns([&](float x) { return chain.process(x); }));
+  TEST_MESSAGE(line);
+  TEST_ASSERT_TRUE(std::isfinite(sink));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_median_rejects_spike);
+  RUN_TEST(test_median_window_of_one_passes_through);
+  RUN_TEST(test_lowpass_response);
+  RUN_TEST(test_notch_response);
+  RUN_TEST(test_biquads_have_unity_dc_gain);
+  RUN_TEST(test_chain_starts_from_first_reading);
+  RUN_TEST(test_stages_above_nyquist_are_left_out);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * SimActuator on the host: the first-order lags of the speed and steering
+ * model, and the brake commands. The model runs on the wall clock, so the
+ * checks leave room for the scheduling of the test process.
+ *
+ */
+#include "Actuation/sim_actuator.hpp"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <unity.h>
+
+using tritonai::gkc::SimActuator;
+
+namespace {
+void wait_s(float seconds) {
+  std::this_thread::sleep_for(std::chrono::duration<float>(seconds));
+}
+
+// value of a first-order lag from 0 towards target after t
+float lag(float target, float t, float tau) {
+  return target * (1.0f - std::exp(-t / tau));
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_starts_at_rest() {
+  SimActuator sim;
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, sim.get_speed());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, sim.get_steer_angle());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, sim.get_brake_position());
+  TEST_ASSERT_FALSE(sim.has_steer_current());
+}
+
+void test_speed_follows_with_lag() {
+  SimActuator sim;
+  sim.set_speed(2.0f);
+  wait_s(SIM_SPEED_TAU_S);
+  const float speed = sim.get_speed();
+  // at least one time constant passed, but not much more
+  TEST_ASSERT_TRUE(speed >= lag(2.0f, SIM_SPEED_TAU_S, SIM_SPEED_TAU_S));
+  TEST_ASSERT_TRUE(speed < lag(2.0f, 2.0f * SIM_SPEED_TAU_S, SIM_SPEED_TAU_S));
+}
+
+void test_steering_follows_with_lag() {
+  SimActuator sim;
+  sim.set_steer_angle(-0.3f);
+  wait_s(3.0f * SIM_STEER_TAU_S);
+  TEST_ASSERT_FLOAT_WITHIN(0.3f * 0.06f, -0.3f, sim.get_steer_angle());
+}
+
+void test_brakes_stop_the_model() {
+  SimActuator sim;
+  sim.set_speed(2.0f);
+  wait_s(SIM_SPEED_TAU_S);
+  const float moving = sim.get_speed();
+  sim.set_drive_brake(0.5f);
+  wait_s(SIM_SPEED_TAU_S);
+  TEST_ASSERT_TRUE(sim.get_speed() < moving * 0.5f);
+
+  sim.set_speed(2.0f);
+  sim.stop_all();
+  wait_s(SIM_SPEED_TAU_S);
+  TEST_ASSERT_TRUE(sim.get_speed() < moving * 0.5f);
+}
+
+void test_zero_brake_keeps_speed_target() {
+  SimActuator sim;
+  sim.set_speed(2.0f);
+  sim.set_drive_brake(0.0f);
+  wait_s(SIM_SPEED_TAU_S);
+  TEST_ASSERT_TRUE(sim.get_speed() >= lag(2.0f, SIM_SPEED_TAU_S, SIM_SPEED_TAU_S));
+}
+
+void test_brake_position_is_held() {
+  SimActuator sim;
+  sim.set_brake_position(1200.0f);
+  TEST_ASSERT_EQUAL_FLOAT(1200.0f, sim.get_brake_position());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_starts_at_rest);
+  RUN_TEST(test_speed_follows_with_lag);
+  RUN_TEST(test_steering_follows_with_lag);
+  RUN_TEST(test_brakes_stop_the_model);
+  RUN_TEST(test_zero_brake_keeps_speed_target);
+  RUN_TEST(test_brake_position_is_held);
+  return UNITY_END();
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * SpeedController on the host: the acceleration and deceleration limits of
+ * the ramp, the slip band and the hold of the ramp and integrator while it
+ * cuts the command back.
+ *
+ */
+#include "Actuation/speed_controller.hpp"
+#include <unity.h>
+
+using tritonai::gkc::SpeedController;
+
+namespace {
+constexpr float DT = PID_INTERVAL_MS / 1000.0f;
+
+float band_high(float ground) {
+  return ground + ground * TRACTION_MAX_SLIP + TRACTION_SLIP_MARGIN_MS;
+}
+
+// runs the loop without a ground speed, returns the last command
+float run_open(SpeedController &ctl, float seconds) {
+  float command = 0.0f;
+  for (int i = 0; i < seconds / DT; ++i) {
+    command = ctl.update(0.0f, false, command, DT);
+  }
+  return command;
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_acceleration_limit() {
+  SpeedController ctl;
+  ctl.reset(0.0f);
+  ctl.set_target(20.0f);
+  TEST_ASSERT_TRUE(run_open(ctl, 1.0f) <= SPEED_MAX_ACCEL_MS2 * 1.0f);
+}
+
+void test_deceleration_reaches_its_limit() {
+  // the deceleration limit is above the acceleration limit and nothing
+  // else in the chain may cap it
+  SpeedController ctl;
+  ctl.reset(20.0f);
+  ctl.set_target(0.0f);
+  const float command = run_open(ctl, 2.0f);
+  TEST_ASSERT_TRUE(command < 20.0f - SPEED_MAX_ACCEL_MS2 * 2.0f);
+  TEST_ASSERT_TRUE(command >= 20.0f - SPEED_MAX_DECEL_MS2 * 2.0f);
+}
+
+void test_slip_band_caps_command() {
+  const float ground = 5.0f;
+  SpeedController ctl;
+  ctl.reset(ground);
+  ctl.set_target(20.0f);
+  bool limited = false;
+  for (int i = 0; i < 2.0f / DT; ++i) {
+    const float command = ctl.update(ground, true, ground, DT);
+    TEST_ASSERT_TRUE(command <= band_high(ground) + 1e-4f);
+    limited = limited || ctl.is_limiting();
+  }
+  TEST_ASSERT_TRUE(limited);
+}
+
+void test_no_windup_while_limiting() {
+  const float ground = 5.0f;
+  SpeedController ctl;
+  ctl.reset(ground);
+  ctl.set_target(20.0f);
+  for (int i = 0; i < 5.0f / DT; ++i) {
+    ctl.update(ground, true, ground, DT);
+  }
+
+  // the driver lifts: with the ramp and integrator held at the band, the
+  // command settles quickly. A wound up integrator would sit at the trim
+  // limit and keep the motor ahead of the wheels.
+  ctl.set_target(ground);
+  float command = 0.0f;
+  for (int i = 0; i < 1.0f / DT; ++i) {
+    command = ctl.update(ground, true, ground, DT);
+  }
+  TEST_ASSERT_FALSE(ctl.is_limiting());
+  TEST_ASSERT_FLOAT_WITHIN(SPEED_TRIM_MAX_MS / 4.0f, ground, command);
+}
+
+void test_reset_restarts_ramp() {
+  SpeedController ctl;
+  ctl.reset(3.0f);
+  ctl.set_target(3.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.0f, ctl.update(0.0f, false, 3.0f, DT));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_acceleration_limit);
+  RUN_TEST(test_deceleration_reaches_its_limit);
+  RUN_TEST(test_slip_band_caps_command);
+  RUN_TEST(test_no_windup_while_limiting);
+  RUN_TEST(test_reset_restarts_ramp);
+  return UNITY_END();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * SteeringController on the host: feedforward inside the deadband, current
+ * limits and conditional integration while saturated.
+ *
+ */
+#include "Actuation/steering_controller.hpp"
+#include <unity.h>
+
+using tritonai::gkc::SteeringController;
+
+namespace {
+constexpr float DT = PID_INTERVAL_MS / 1000.0f;
+constexpr float DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+
+// holds the measurement for a while, returns the last output
+float hold(SteeringController &ctl, float measured, float seconds) {
+  float current = 0.0f;
+  for (int i = 0; i < seconds / DT; ++i) {
+    current = ctl.update(measured, DT);
+  }
+  return current;
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_deadband_leaves_feedforward() {
+  SteeringController ctl;
+  ctl.set_target(0.1f);
+  const float measured = 0.1f + STEER_DEADBAND_DEG * 0.5f * DEG_TO_RAD;
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.1f * STEADY_STATE_CURRENT_MULT_POS,
+                           hold(ctl, measured, 1.0f));
+
+  ctl.set_target(-0.1f);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, -0.1f * STEADY_STATE_CURRENT_MULT_NEG,
+                           hold(ctl, -measured, 1.0f));
+}
+
+void test_output_is_clamped() {
+  SteeringController ctl;
+  ctl.set_target(1.0f);
+  TEST_ASSERT_EQUAL_FLOAT(MAX_STEER_CURRENT_MA, ctl.update(0.0f, DT));
+  ctl.reset();
+  ctl.set_target(-1.0f);
+  TEST_ASSERT_EQUAL_FLOAT(MIN_STEER_CURRENT_MA, ctl.update(0.0f, DT));
+}
+
+void test_no_windup_while_saturated() {
+  // feedforward and P alone reach the limit, so the integrator must not
+  // grow while the column is held
+  const float target = float{MAX_STEER_CURRENT_MA} /
+                       (STEADY_STATE_CURRENT_MULT_POS + STEER_P);
+  SteeringController ctl;
+  ctl.set_target(target);
+  TEST_ASSERT_EQUAL_FLOAT(MAX_STEER_CURRENT_MA, hold(ctl, 0.0f, 5.0f));
+
+  // once released, the output settles at the feedforward instead of
+  // unwinding five seconds of error
+  const float released = hold(ctl, target, 1.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * MAX_STEER_CURRENT_MA,
+                           target * STEADY_STATE_CURRENT_MULT_POS, released);
+}
+
+void test_reset_forgets_integrator() {
+  SteeringController ctl;
+  ctl.set_target(0.05f);
+  hold(ctl, 0.0f, 1.0f);
+  ctl.reset();
+  ctl.set_target(0.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, ctl.update(0.0f, DT));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_deadband_leaves_feedforward);
+  RUN_TEST(test_output_is_clamped);
+  RUN_TEST(test_no_windup_while_saturated);
+  RUN_TEST(test_reset_forgets_integrator);
+  return UNITY_END();
+}
@@ -0,0 +1,80 @@
+/**
+ * @file test_main.cpp
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright 2022 Triton AI
+ *
+ * Interpolation of the steering table on the host, both ways, against the
+ * rows of the built configuration.
+ *
+ */
+#include "Actuation/steering_map.hpp"
+#include <unity.h>
+
+using namespace tritonai::gkc;
+
+namespace {
+constexpr float EPS = 1e-5f;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_exact_at_rows() {
+  for (size_t i = 0; i < steering_map::NUM_POINTS; ++i) {
+    const auto &p = steering_map::POINTS[i];
+    TEST_ASSERT_FLOAT_WITHIN(EPS, p.motor, map_steer2motor(p.steer));
+  }
+}
+
+void test_interpolates_between_rows() {
+  for (size_t i = 0; i + 1 < steering_map::NUM_POINTS; ++i) {
+    const auto &a = steering_map::POINTS[i];
+    const auto &b = steering_map::POINTS[i + 1];
+    TEST_ASSERT_FLOAT_WITHIN(EPS, (a.motor + b.motor) / 2.0f,
+                             map_steer2motor((a.steer + b.steer) / 2.0f));
+  }
+}
+
+void test_is_mirrored() {
+  const float steer = steering_map::MAX_STEER / 3.0f;
+  TEST_ASSERT_EQUAL_FLOAT(-map_steer2motor(steer), map_steer2motor(-steer));
+}
+
+void test_held_past_the_table() {
+  TEST_ASSERT_EQUAL_FLOAT(steering_map::MAX_MOTOR,
+                          map_steer2motor(steering_map::MAX_STEER * 2.0f));
+  TEST_ASSERT_EQUAL_FLOAT(-steering_map::MAX_MOTOR,
+                          map_steer2motor(-steering_map::MAX_STEER * 2.0f));
+}
+
+void test_inverse_at_rows_and_ends() {
+  for (size_t i = 0; i < steering_map::NUM_POINTS; ++i) {
+    const auto &p = steering_map::POINTS[i];
+    TEST_ASSERT_FLOAT_WITHIN(EPS, p.steer, map_motor2steer(p.motor));
+    TEST_ASSERT_FLOAT_WITHIN(EPS, -p.steer, map_motor2steer(-p.motor));
+  }
+  TEST_ASSERT_EQUAL_FLOAT(steering_map::MAX_STEER,
+                          map_motor2steer(steering_map::MAX_MOTOR * 2.0f));
+}
+
+void test_inverse_round_trip() {
+  for (int i = -20; i <= 20; ++i) {
+    const float steer = steering_map::MAX_STEER * i / 20.0f;
+    TEST_ASSERT_FLOAT_WITHIN(EPS, steer,
+                             map_motor2steer(map_steer2motor(steer)));
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_exact_at_rows);
+  RUN_TEST(test_interpolates_between_rows);
+  RUN_TEST(test_is_mirrored);
+  RUN_TEST(test_held_past_the_table);
+  RUN_TEST(test_inverse_at_rows_and_ends);
+  RUN_TEST(test_inverse_round_trip);
+  return UNITY_END();
+}